@@ -0,0 +1,189 @@
+/* Host benchmark of compressed vs uncompressed API responses.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Usage:
+ *   inflate_bench [response.json] [cpu scale]
+ *
+ * Replays a response body uncompressed and compressed the ways a server may
+ * answer "Accept-Encoding: gzip, deflate", reads each back through
+ * InflateStream the way getData does, and checks that the output matches.
+ * Reports the bytes on air, the time to inflate, and the total time of each
+ * replay over a few link throughputs.
+ *
+ * The inflate time is measured on the host. Pass cpu scale, the ratio of the
+ * device's time to the host's (e.g. from PROF_JSON_PARSE of the phase
+ * profiler), to estimate the total on the device.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <zlib.h>
+
+#include "inflate_stream.h"
+
+// effective throughput of the TLS connection, in bits per second
+static const double LINK_RATES[] = {0.5e6, 2e6, 8e6};
+static const int NUM_LINK_RATES = sizeof(LINK_RATES) / sizeof(LINK_RATES[0]);
+
+/* Stream over a recorded response body, as http.getStream() is for getData.
+ */
+class ReplayStream : public Stream
+{
+public:
+  ReplayStream(const std::vector<uint8_t> &body) : body(body), pos(0) {}
+
+  int available() override { return static_cast<int>(body.size() - pos); }
+  int read() override { return pos < body.size() ? body[pos++] : -1; }
+  int peek() override { return pos < body.size() ? body[pos] : -1; }
+  size_t write(uint8_t) override { return 0; }
+
+private:
+  const std::vector<uint8_t> &body;
+  size_t pos;
+};
+
+struct Encoding
+{
+  const char *name;
+  int windowBits; // 0 for identity, as deflateInit2
+  int level;
+  InflateStream::Format format;
+};
+
+static const Encoding ENCODINGS[] = {
+  {"identity",          0, 0, InflateStream::DEFLATE},
+  {"gzip -1",     15 + 16, 1, InflateStream::GZIP},
+  {"gzip -6",     15 + 16, 6, InflateStream::GZIP},
+  {"gzip -9",     15 + 16, 9, InflateStream::GZIP},
+  {"deflate -6",       15, 6, InflateStream::DEFLATE},
+  {"raw deflate -6",  -15, 6, InflateStream::DEFLATE},
+};
+
+static std::vector<uint8_t> compress(const std::vector<uint8_t> &in,
+                                     const Encoding &e)
+{
+  z_stream z = {};
+  deflateInit2(&z, e.level, Z_DEFLATED, e.windowBits, 8, Z_DEFAULT_STRATEGY);
+  std::vector<uint8_t> out(deflateBound(&z, in.size()));
+  z.next_in = const_cast<uint8_t *>(in.data());
+  z.avail_in = in.size();
+  z.next_out = out.data();
+  z.avail_out = out.size();
+  deflate(&z, Z_FINISH);
+  out.resize(z.total_out);
+  deflateEnd(&z);
+  return out;
+} // end compress
+
+/* Reads the whole response back as the JSON deserializer would, one byte at a
+ * time. Returns false if the output does not match the original.
+ */
+static bool replay(const std::vector<uint8_t> &body, const Encoding &e,
+                   const std::vector<uint8_t> &expected)
+{
+  ReplayStream raw(body);
+  InflateStream inflateStream(raw, e.format);
+  Stream *response = &raw;
+  if (e.windowBits != 0)
+  {
+    if (!inflateStream.begin())
+    {
+      return false;
+    }
+    response = &inflateStream;
+  }
+  size_t n = 0;
+  int c;
+  while ((c = response->read()) >= 0)
+  {
+    if (n >= expected.size() || c != expected[n])
+    {
+      return false;
+    }
+    ++n;
+  }
+  return n == expected.size() && !inflateStream.failed();
+} // end replay
+
+int main(int argc, char **argv)
+{
+  const char *path = argc >= 2 ? argv[1] : "onecall.json";
+  double cpuScale = argc >= 3 ? atof(argv[2]) : 1.0;
+
+  FILE *f = fopen(path, "rb");
+  if (f == nullptr)
+  {
+    perror(path);
+    return 2;
+  }
+  std::vector<uint8_t> original;
+  int c;
+  while ((c = fgetc(f)) != EOF)
+  {
+    original.push_back(static_cast<uint8_t>(c));
+  }
+  fclose(f);
+
+  printf("%s, %zu bytes, cpu scale %g\n\n", path, original.size(), cpuScale);
+  printf("%-15s %7s %6s %10s", "encoding", "on air", "ratio", "inflate");
+  for (int r = 0; r < NUM_LINK_RATES; ++r)
+  {
+    char label[32];
+    snprintf(label, sizeof(label), "total @%.1f Mbit/s", LINK_RATES[r] / 1e6);
+    printf(" %20s", label);
+  }
+  printf("\n");
+
+  bool ok = true;
+  for (const Encoding &e : ENCODINGS)
+  {
+    std::vector<uint8_t> body = e.windowBits == 0 ? original
+                                                  : compress(original, e);
+    if (!replay(body, e, original))
+    {
+      printf("%-15s output does not match\n", e.name);
+      ok = false;
+      continue;
+    }
+
+    // repeat for at least 200ms for a stable average
+    using clock = std::chrono::steady_clock;
+    int reps = 0;
+    auto start = clock::now();
+    double elapsed;
+    do
+    {
+      replay(body, e, original);
+      ++reps;
+      elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < 0.2);
+    double inflateMs = elapsed / reps * 1e3 * cpuScale;
+
+    printf("%-15s %7zu %6.2f %7.3f ms", e.name, body.size(),
+           static_cast<double>(body.size()) / original.size(), inflateMs);
+    for (int r = 0; r < NUM_LINK_RATES; ++r)
+    {
+      double airMs = body.size() * 8 / LINK_RATES[r] * 1e3;
+      printf(" %17.2f ms", airMs + inflateMs);
+    }
+    printf("\n");
+  }
+  return ok ? 0 : 1;
+} // end main
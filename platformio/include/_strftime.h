@@ -18,10 +18,40 @@
 #ifndef ___STRFTIME_H__
 #define ___STRFTIME_H__
 
+#include <stdint.h>
 #include <time.h>
+#include "calendar.h"
+
+#define STRFTIME_PROG_MAX_OPS 16
+
+/* A format string compiled by _strftime_compile.
+ *
+ * Literal text and the common conversions (numeric fields, day/month names and
+ * am/pm) are executed directly. Conversions with flags, field widths or
+ * modifiers, and the rarely used ones, are handed to _strftime.
+ */
+typedef struct strftime_op
+{
+  char conv;      // conversion character, or '\0' for literal text
+  uint8_t start;  // offset of the text (or '%' of the conversion) in format
+  uint8_t len;    // length of the text (or conversion specification)
+} strftime_op_t;
+
+typedef struct strftime_prog
+{
+  const char *format;
+  bool compiled;  // false if format is interpreted by _strftime instead
+  uint8_t num_ops;
+  strftime_op_t ops[STRFTIME_PROG_MAX_OPS];
+} strftime_prog_t;
 
 size_t _strftime(char *s, size_t maxsize, const char *format,
                  const struct tm *timeptr);
+void _strftime_compile(strftime_prog_t &prog, const char *format);
+size_t _strftime(char *s, size_t maxsize, const strftime_prog_t &prog,
+                 const struct tm *timeptr);
+size_t _strftime_hours(char *s, size_t maxsize, const strftime_prog_t &prog,
+                       calendar_t &cal, int64_t utc);
 
 #endif
 
@@ -21,7 +21,9 @@
 #define OWM_NUM_HOURLY 48        // 48
 #define OWM_NUM_DAILY 8          // 8
 #define OWM_NUM_ALERTS 8         // OpenWeatherMaps does not specify a limit, but if you need more alerts you are probably doomed.
+#define OWM_ALERTS_POOL_SIZE 768 // Bytes of event and tag text shared by all alerts
 #define OWM_NUM_AIR_POLLUTION 24 // Depending on AQI scale, hourly concentrations will need to be averaged over a period of 1h to 24h
+#define NUM_FORECAST_DAYS 5      // Days shown by drawForecast, today included
 
 /*
  * Units – default: kelvin, metric: Celsius, imperial: Fahrenheit.
@@ -92,12 +94,32 @@ typedef struct owm_daily
 /*
  * National weather alerts data from major national weather warning systems
  */
+typedef struct owm_span
+{
+  uint16_t offset;    // Offset of the null-terminated text in the pool
+  uint16_t length;    // Length of the text, excluding the terminator
+} owm_span_t;
+
 typedef struct owm_alerts
 {
-  String event;       // Alert event name
-  String tags;        // Type of severe weather
+  owm_span_t event;   // Alert event name
+  owm_span_t tags;    // Type of severe weather (first tag)
+  int8_t urgency;     // Index of the matching ALERT_URGENCY keyword, set by filterAlerts
+  int8_t category;    // enum alert_category, set by filterAlerts
 } owm_alerts_t;
 
+/*
+ * Fixed capacity alert storage. The text of every alert lives in a single
+ * pool so that no heap is used and it can be edited in place.
+ */
+typedef struct owm_resp_alerts
+{
+  int num;                            // Number of alerts in list
+  owm_alerts_t list[OWM_NUM_ALERTS];
+  uint16_t pool_used;                 // Bytes of pool in use
+  char pool[OWM_ALERTS_POOL_SIZE];
+} owm_resp_alerts_t;
+
 /*
  * Response from OpenWeatherMap's OneCall API
  *
@@ -108,7 +130,7 @@ typedef struct owm_resp_onecall
   owm_current_t current;
   owm_hourly_t hourly[OWM_NUM_HOURLY];
   owm_daily_t daily[OWM_NUM_DAILY];
-  std::vector<owm_alerts_t> alerts;
+  owm_resp_alerts_t alerts;
 } owm_resp_onecall_t;
 
 typedef struct owm_components
@@ -129,6 +151,10 @@ typedef struct owm_components
 typedef struct owm_resp_air_pollution
 {
   owm_components_t components;
+  // Derived from components once per refresh, see calcAirQuality.
+  int aqi;               // Air quality index on the locale's AQI_SCALE
+  const char *aqi_desc;  // Descriptor of aqi
+  const char *aqi_label; // "Air Quality" or "Air Pollution", depends on scale
 } owm_resp_air_pollution_t;
 
 #endif
@@ -0,0 +1,44 @@
+/* Astronomical calculation declarations for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ASTRONOMY_H__
+#define __ASTRONOMY_H__
+
+#include <stdint.h>
+#include "api_response.h"
+
+/* Low precision solar and lunar ephemeris, accurate to a few arcminutes for
+ * the sun and a few tenths of a degree for the moon. Rise and set times are
+ * typically within a couple of minutes.
+ *
+ * Times are Unix, UTC. A day is the 24 hours starting at dayStart, and a rise
+ * or set that does not happen within it is reported as 0, like OpenWeatherMap.
+ */
+void calcSunRiseSet(int64_t dayStart, double lat, double lon,
+                    int64_t &rise, int64_t &set);
+void calcMoonRiseSet(int64_t dayStart, double lat, double lon,
+                     int64_t &rise, int64_t &set);
+float calcMoonPhase(int64_t t);
+
+/* Fills moonrise, moonset and moon_phase of the first 'days' entries of
+ * r.daily, whose dt must be the start of each local day, and sets
+ * r.current.sunrise and r.current.sunset from the first day. Results are
+ * cached per day in RTC memory, so each day is only computed once.
+ */
+void fillAstronomy(owm_resp_onecall_t &r, int days);
+
+#endif
@@ -0,0 +1,41 @@
+/* Battery ULP declarations for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __BATTERY_ULP_H__
+#define __BATTERY_ULP_H__
+
+#include <stdint.h>
+#include "config.h"
+
+/* Battery voltage over one deep sleep, as sampled by the ULP coprocessor.
+ */
+typedef struct battery_ulp_stats
+{
+  uint16_t min_mv;
+  uint16_t max_mv;
+  uint16_t avg_mv;
+  uint16_t samples;
+} battery_ulp_stats_t;
+
+#if ULP_BATTERY_MONITORING
+void collectBatteryUlp();
+bool startBatteryUlp(uint32_t lowVoltage, uint32_t highVoltage);
+uint32_t getBatteryUlpHistory(const battery_ulp_stats_t *&stats);
+void printBatteryUlpHistory();
+#endif
+
+#endif
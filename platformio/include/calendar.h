@@ -0,0 +1,66 @@
+/* Calendar iterator declarations for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CALENDAR_H__
+#define __CALENDAR_H__
+
+#include <stdint.h>
+#include <time.h>
+
+/* A daylight saving time transition rule of a POSIX TZ string.
+ *   Jn    : day n (1 - 365) of the year, February 29th is never counted
+ *   n     : day n (0 - 365) of the year, counting February 29th
+ *   Mm.w.d: day d (0 = Sunday) of week w (1 - 5, 5 = last) of month m
+ */
+typedef struct tz_rule
+{
+  char type;      // 'J', 'D' (n) or 'M'
+  int16_t day;
+  int8_t week;
+  int8_t month;
+  int32_t time;   // local time of day of the transition, seconds
+} tz_rule_t;
+
+typedef struct posix_tz
+{
+  int32_t std_offset; // seconds east of UTC
+  int32_t dst_offset; // seconds east of UTC
+  bool has_dst;
+  tz_rule_t start;    // start of daylight saving time, in standard time
+  tz_rule_t end;      // end of daylight saving time, in daylight saving time
+} posix_tz_t;
+
+/* Iterates over local calendar time. The UTC offset and the time of the next
+ * daylight saving time transition are kept, so moving between nearby times is
+ * a few additions rather than a call to localtime.
+ */
+typedef struct calendar
+{
+  int64_t utc;          // Unix time
+  struct tm local;      // broken-down local time of utc
+  int32_t utc_offset;   // seconds east of UTC in effect at utc
+  int64_t prev_change;  // last UTC offset change at or before utc
+  int64_t next_change;  // next UTC offset change after utc
+} calendar_t;
+
+bool parsePosixTZ(const char *tz, posix_tz_t &z);
+int32_t utcOffsetAt(const posix_tz_t &z, int64_t t,
+                    int64_t &prevChange, int64_t &nextChange);
+void calendarBegin(calendar_t &cal, int64_t utc);
+void calendarAdvance(calendar_t &cal, int64_t utc);
+
+#endif
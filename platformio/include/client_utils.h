@@ -28,6 +28,9 @@ bool waitForSNTPSync(tm *timeInfo);
 bool printLocalTime(tm *timeInfo);
 
 bool makeAPICalls(owm_resp_onecall_t &resp_main, owm_resp_air_pollution_t &resp_pollution);
+#if TELEMETRY
+void uploadTelemetry();
+#endif
 
 template <typename T>
 int getData(WiFiClient &client, String host, String url, T &r, DeserializationError(*deserializeCall)(Stream&, T&));
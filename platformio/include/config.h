@@ -45,6 +45,127 @@
   #define HTTP_MODE HTTPS_WITH_CERT_VERIF
 #endif
 
+// HTTP COMPRESSION
+// When enabled, API responses are requested gzip or deflate encoded and are
+// inflated while they are parsed. The JSON responses compress to roughly a
+// fifth of their size, shortening the time the radio has to stay on, at the
+// cost of a 32KiB history window allocated for the duration of each request.
+#ifndef HTTP_COMPRESSION
+  #define HTTP_COMPRESSION 1
+#endif
+
+// WAKE CYCLE PROFILING
+// When enabled, the time spent in each phase of a wake cycle (sensor read,
+// WiFi, each stage of the HTTP requests, each widget, the panel refresh, ...)
+// is measured and the last PROFILE_HISTORY cycles are kept in RTC memory. With
+// DEBUG_LEVEL >= 1 a table of the phases is printed before entering deep sleep.
+// Timing each read of the response body adds a few milliseconds per request.
+#ifndef PHASE_PROFILING
+  #define PHASE_PROFILING (DEBUG_LEVEL >= 1 || STATUS_BAR_EXTRAS_BAT_LIFE \
+                           || TELEMETRY)
+#endif
+#ifndef PROFILE_HISTORY
+  #define PROFILE_HISTORY 8
+#endif
+
+// ENERGY ESTIMATION
+// Combines the profiled phase times with the power model in config.cpp to
+// estimate the charge drawn per wake and the remaining battery life. The
+// estimates are printed with DEBUG_LEVEL >= 1 and drawn in the status bar with
+// STATUS_BAR_EXTRAS_BAT_LIFE. Requires PHASE_PROFILING.
+#ifndef ENERGY_ESTIMATION
+  #define ENERGY_ESTIMATION (PHASE_PROFILING && BATTERY_MONITORING)
+#endif
+#if ENERGY_ESTIMATION && !PHASE_PROFILING
+  #error "ENERGY_ESTIMATION requires PHASE_PROFILING"
+#endif
+
+// TELEMETRY
+// When enabled (telemetry in config.json), a record of each wake cycle (wake
+// reason, time awake, phase times, RSSI, battery voltage, HTTP status, bytes
+// received, parse error and the kind of display update) is kept in a ring of
+// TELEMETRY_RECORDS in RTC memory. The records are printed as CSV at boot while
+// PIN_TELEMETRY_DUMP is held low, and, if a telemetryUrl is set, the records
+// not yet sent are POSTed to it as CSV after the API requests of the next wake.
+// Each record takes 60 bytes of the 8KiB of RTC slow memory. Requires
+// PHASE_PROFILING.
+#ifndef TELEMETRY_RECORDS
+  #define TELEMETRY_RECORDS 32
+#endif
+#if TELEMETRY && !PHASE_PROFILING
+  #error "TELEMETRY requires PHASE_PROFILING"
+#endif
+
+// POWER TIERS
+// When enabled (powerTiers in config.json), features are shed in steps as the
+// battery voltage falls past the POWER_TIER_*_VOLTAGEs in config.cpp, and the
+// tier is shown in the status bar. Requires BATTERY_MONITORING.
+#if POWER_TIERS && !BATTERY_MONITORING
+  #error "POWER_TIERS requires BATTERY_MONITORING"
+#endif
+
+// ULP BATTERY MONITORING
+// When enabled (ulpBatteryMonitoring in config.json), the ULP coprocessor
+// samples the battery during deep sleep and wakes the esp32 when a threshold
+// in config.cpp is crossed, see ULP_BATTERY_INTERVAL. The minimum, mean and
+// maximum voltage over each of the last deep sleeps are kept in RTC memory and
+// printed with DEBUG_LEVEL >= 1. PIN_BAT_ADC must be an ADC1 pin. Requires
+// BATTERY_MONITORING and the original esp32, the ULP of later chips differs.
+#if ULP_BATTERY_MONITORING && !BATTERY_MONITORING
+  #error "ULP_BATTERY_MONITORING requires BATTERY_MONITORING"
+#endif
+#if ULP_BATTERY_MONITORING && !CONFIG_IDF_TARGET_ESP32
+  #error "ULP_BATTERY_MONITORING is only supported on the esp32"
+#endif
+
+// INDOOR HISTORY
+// When enabled (displayIndoorHistory in config.json), the last
+// INDOOR_HISTORY_READINGS indoor temperature and humidity readings are kept in
+// RTC memory, 8 bytes each, and the last 24 hours are drawn as a sparkline
+// next to the indoor widgets. The 24 hour range is printed with
+// DEBUG_LEVEL >= 1. Readings are dated, so they are only kept once the time has
+// been synchronized.
+#ifndef INDOOR_HISTORY
+  #define INDOOR_HISTORY DISPLAY_INDOOR_HISTORY
+#endif
+#ifndef INDOOR_HISTORY_READINGS
+  #define INDOOR_HISTORY_READINGS 48
+#endif
+
+// INDOOR AIR QUALITY
+// When a position is set (posInIAQ in config.json), the gas sensor of the
+// BME680 is heated to 320C for 150ms each wake and an indoor air quality index,
+// 0 (clean) to 500, is drawn. The measurement runs while WiFi connects. The
+// index compares the gas resistance to a baseline of the cleanest air seen,
+// kept in RTC memory and stored in NVS whenever it moves by more than 2%, and
+// takes a few days to settle after the sensor is first powered. Without a
+// position the heater is left off. Requires the BME680.
+#if defined(POS_IN_IAQ) && SENSOR != BME680
+  #error "POS_IN_IAQ requires the BME680"
+#endif
+
+// RESPONSE FIELDS
+// The optional fields of the weather API response are requested and kept by
+// the deserialization filter when any enabled feature reads them, not only the
+// widgets. ADAPTIVE_SLEEP reads the hourly probability of precipitation and
+// weather conditions, and the number of alerts. A field that is filtered out
+// reads as 0.
+#define FETCH_HOURLY_POP      (UNITS_HOURLY_PRECIP == POP || ADAPTIVE_SLEEP)
+#define FETCH_HOURLY_PRECIP   (UNITS_HOURLY_PRECIP != POP)
+#define FETCH_HOURLY_WEATHER  (DISPLAY_HOURLY_ICONS || ADAPTIVE_SLEEP)
+#define FETCH_ALERTS          (DISPLAY_ALERTS || ADAPTIVE_SLEEP)
+
+// HEAP TRACKING
+// When enabled, the free heap, its low-water mark and the largest free block
+// are sampled at the boundaries of the wake cycle (WiFi, TLS, JsonDocument,
+// parse, alerts, render). With DEBUG_LEVEL >= 1 they are printed before deep
+// sleep, along with the phase that shrank the largest free block the most.
+// The largest free block bounds the JsonDocument, so fragmentation shows up
+// there first as -256 - NoMemory deserialization errors.
+#ifndef HEAP_TRACKING
+  #define HEAP_TRACKING (DEBUG_LEVEL >= 1)
+#endif
+
 // NON-VOLATILE STORAGE (NVS) NAMESPACE
 #ifndef NVS_NAMESPACE
   #define NVS_NAMESPACE "weather_epd"
@@ -64,13 +185,28 @@ extern const char *HOUR_FORMAT;
 extern const char *NTP_SERVER_1;
 extern const char *NTP_SERVER_2;
 extern const unsigned long NTP_TIMEOUT;
+extern const float ADAPTIVE_SLEEP_TEMP_DELTA;
+extern const int ADAPTIVE_SLEEP_POP;
 extern const uint32_t WARN_BATTERY_VOLTAGE;
 extern const uint32_t LOW_BATTERY_VOLTAGE;
 extern const uint32_t VERY_LOW_BATTERY_VOLTAGE;
 extern const uint32_t CRIT_LOW_BATTERY_VOLTAGE;
 extern const unsigned long LOW_BATTERY_SLEEP_INTERVAL;
 extern const unsigned long VERY_LOW_BATTERY_SLEEP_INTERVAL;
+extern const uint32_t BATTERY_HYSTERESIS;
+extern const uint32_t POWER_TIER_1_VOLTAGE;
+extern const uint32_t POWER_TIER_2_VOLTAGE;
+extern const uint32_t POWER_TIER_3_VOLTAGE;
+extern const unsigned long POWER_TIER_WIFI_TIMEOUT;
+extern const unsigned POWER_TIER_HTTP_TIMEOUT;
+extern const unsigned long ULP_BATTERY_INTERVAL;
+extern const uint32_t ULP_BATTERY_HYSTERESIS;
 extern const uint32_t MAX_BATTERY_VOLTAGE;
 extern const uint32_t MIN_BATTERY_VOLTAGE;
+extern const uint32_t BATTERY_CAPACITY;
+extern const float CURRENT_RADIO;
+extern const float CURRENT_CPU;
+extern const float CURRENT_REFRESH;
+extern const float CURRENT_DEEP_SLEEP;
 
 #endif
@@ -49,28 +49,37 @@ enum alert_category {
   STRONG_WIND
 };
 
+typedef enum battery_state
+{
+  BATTERY_OK,
+  BATTERY_LOW,
+  BATTERY_VERY_LOW,
+  BATTERY_CRIT_LOW
+} battery_state_t;
+
+uint32_t batteryAdcToVoltage(uint32_t adc_val);
 uint32_t readBatteryVoltage();
+battery_state_t getBatteryState(uint32_t batVoltage, battery_state_t prev);
 uint32_t calcBatPercent(uint32_t v, uint32_t minv, uint32_t maxv);
 const uint8_t *getBatBitmap24(uint32_t batPercent);
 void getDateStr(String &s, tm *timeInfo);
 void getRefreshTimeStr(String &s, bool timeSuccess, tm *timeInfo);
-void toTitleCase(String &text);
-void truncateExtraAlertInfo(String &text);
-void filterAlerts(std::vector<owm_alerts_t> &resp, int *ignore_list);
+void toTitleCase(char *text);
+size_t truncateExtraAlertInfo(char *text);
+void filterAlerts(owm_resp_alerts_t &alerts, uint32_t &ignore_list);
 const char *getUVIdesc(unsigned int uvi);
-float getAvgConc(const float pollutant[], int hours);
-int getAQI(const owm_resp_air_pollution_t &p);
-const char *getAQIdesc(int aqi);
+void calcAirQuality(owm_resp_air_pollution_t &p);
 const char *getWiFidesc(int rssi);
 const uint8_t *getWiFiBitmap16(int rssi);
+int getConditionGroup(int id);
 const uint8_t *getHourlyForecastBitmap32(const owm_hourly_t &hourly,
                                          const owm_daily_t  &today);
 const uint8_t *getDailyForecastBitmap64(const owm_daily_t &daily);
 const uint8_t *getCurrentConditionsBitmap196(const owm_current_t &current,
                                              const owm_daily_t   &today);
-const uint8_t *getAlertBitmap32(const owm_alerts_t &alert);
-const uint8_t *getAlertBitmap48(const owm_alerts_t &alert);
-enum alert_category getAlertCategory(const owm_alerts_t &alert);
+const uint8_t *getAlertBitmap32(enum alert_category c);
+const uint8_t *getAlertBitmap48(enum alert_category c);
+void classifyAlert(const char *event, int8_t &urgency, int8_t &category);
 const uint8_t *getWindBitmap24(int windDeg);
 const char *getCompassPointNotation(int windDeg);
 const char *getHttpResponsePhrase(int code);
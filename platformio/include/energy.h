@@ -0,0 +1,39 @@
+/* Energy estimation declarations for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ENERGY_H__
+#define __ENERGY_H__
+
+#include <stdint.h>
+#include "config.h"
+#include "profiler.h"
+
+#if ENERGY_ESTIMATION
+
+float wakeCharge(const profile_cycle_t &cycle);
+float averageWakeCharge();
+float wakesPerDay();
+float dailyCharge();
+void recordBatteryVoltage(uint32_t batVoltage);
+float batteryDaysModel(uint32_t batVoltage);
+float batteryDaysTrend();
+float estimateBatteryDays(uint32_t batVoltage);
+void printEnergyEstimate(const profile_cycle_t &cycle);
+
+#endif
+
+#endif
@@ -0,0 +1,50 @@
+/* Heap tracker declarations for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __HEAP_TRACKER_H__
+#define __HEAP_TRACKER_H__
+
+#include <stdint.h>
+#include "config.h"
+
+/* Points of a wake cycle at which the heap is sampled. A change between two
+ * samples is attributed to the phase that ends at the later one.
+ */
+typedef enum heap_point
+{
+  HEAP_BOOT,      // start of setup
+  HEAP_WIFI,      // WiFi connected
+  HEAP_CONNECTED, // connection (and TLS session) set up, headers read
+  HEAP_JSON_DOC,  // response deserialized, JsonDocument still allocated
+  HEAP_PARSED,    // response stored, document and connection released
+  HEAP_WIFI_OFF,  // WiFi stopped
+  HEAP_ALERTS,    // alerts filtered and drawn
+  HEAP_RENDER,    // all pages drawn and refreshed
+  HEAP_SLEEP,     // before deep sleep
+  HEAP_NUM_POINTS
+} heap_point_t;
+
+#if HEAP_TRACKING
+void heapCheckpoint(heap_point_t point);
+void printHeapCheckpoints();
+
+  #define HEAP_CHECKPOINT(point) heapCheckpoint(point)
+#else
+  #define HEAP_CHECKPOINT(point)
+#endif
+
+#endif
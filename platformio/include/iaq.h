@@ -0,0 +1,31 @@
+/* Indoor air quality declarations for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __IAQ_H__
+#define __IAQ_H__
+
+#include <Preferences.h>
+#include "config.h"
+
+#ifdef POS_IN_IAQ
+void loadGasBaseline(Preferences &prefs);
+bool gasBaselineStale();
+void saveGasBaseline(Preferences &prefs);
+int calcIaq(float gasResistance, float humidity);
+#endif
+
+#endif
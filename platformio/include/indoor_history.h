@@ -0,0 +1,48 @@
+/* Indoor history declarations for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __INDOOR_HISTORY_H__
+#define __INDOOR_HISTORY_H__
+
+#include <stdint.h>
+#include <time.h>
+#include "config.h"
+
+// One indoor sensor reading, 8 bytes of RTC memory.
+typedef struct indoor_reading
+{
+  uint32_t time;     // Unix time
+  int16_t temp;      // hundredths of a degree celsius, INT16_MIN if unknown
+  uint8_t humidity;  // percent, UINT8_MAX if unknown
+} indoor_reading_t;
+
+typedef struct indoor_range
+{
+  float temp_min;     // celsius, NAN if unknown
+  float temp_max;
+  float humidity_min; // percent, NAN if unknown
+  float humidity_max;
+} indoor_range_t;
+
+#if INDOOR_HISTORY
+void recordIndoorReading(float inTemp, float inHumidity);
+int getIndoorHistory(indoor_reading_t *readings, time_t since);
+indoor_range_t getIndoorRange(time_t since);
+void printIndoorRange();
+#endif
+
+#endif
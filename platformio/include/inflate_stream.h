@@ -0,0 +1,106 @@
+/* Inflating stream declarations for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __INFLATE_STREAM_H__
+#define __INFLATE_STREAM_H__
+
+#include <Arduino.h>
+
+// Deflate (RFC 1951) permits back-references up to 32KiB, so the history
+// window can not be any smaller without risking corrupt output.
+#define INFLATE_WINDOW_SIZE 32768
+
+/* Stream adapter that decompresses a gzip (RFC 1952), zlib (RFC 1950) or raw
+ * deflate (RFC 1951) encoded upstream on the fly. Bytes are pulled from the
+ * upstream one at a time, only as fast as the reader consumes output, so the
+ * only sizeable allocation is the history window.
+ *
+ * The gzip trailer (CRC-32 and size) is not verified, corrupt input will
+ * surface as a JSON deserialization error instead.
+ */
+class InflateStream : public Stream
+{
+public:
+  enum Format
+  {
+    GZIP,
+    DEFLATE // zlib wrapped, raw deflate is also detected and accepted
+  };
+
+  InflateStream(Stream &upstream, Format format);
+  ~InflateStream();
+
+  bool begin();
+  bool failed() const;
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t readBytes(char *buffer, size_t length) override;
+  size_t write(uint8_t) override;
+
+private:
+  enum State
+  {
+    STATE_HEADER,
+    STATE_BLOCK,
+    STATE_STORED,
+    STATE_HUFFMAN,
+    STATE_DONE,
+    STATE_ERROR
+  };
+
+  struct Huffman
+  {
+    uint16_t *counts;  // number of codes of each length
+    uint16_t *symbols; // symbols ordered by code
+  };
+
+  Stream &upstream;
+  Format format;
+  State state;
+  uint8_t *window;
+  uint32_t windowPos;
+  uint32_t totalOut;
+  uint32_t bitBuf;
+  int bitCnt;
+  bool lastBlock;
+  uint16_t storedLeft;
+  uint16_t matchLeft;
+  uint16_t matchDist;
+  int peeked;
+
+  uint16_t litCounts[16];
+  uint16_t litSymbols[288];
+  uint16_t distCounts[16];
+  uint16_t distSymbols[30];
+  Huffman lit;
+  Huffman dist;
+
+  int nextByte();
+  int fail();
+  int emit(uint8_t c);
+  int getByte();
+  int getBits(int need);
+  int decode(const Huffman &h);
+  bool readHeader();
+  bool readBlockHeader();
+  bool readDynamicTables();
+  static void buildHuffman(Huffman &h, const uint8_t *lengths, int n);
+};
+
+#endif
@@ -0,0 +1,44 @@
+/* Power tier declarations for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __POWER_TIER_H__
+#define __POWER_TIER_H__
+
+#include <stdint.h>
+#include "config.h"
+
+/* Features are shed in steps as the battery drains, each tier keeps the
+ * savings of the ones below it.
+ */
+typedef enum power_tier
+{
+  POWER_TIER_NORMAL,
+  POWER_TIER_1,      // skip the air pollution request, shorter timeouts
+  POWER_TIER_2,      // no hourly icons, sleep twice as long
+  POWER_TIER_3       // indoor readings in the full refresh, sleep 4x as long
+} power_tier_t;
+
+// The tier of this wake cycle. Set from the battery voltage at boot when
+// POWER_TIERS is enabled, otherwise always POWER_TIER_NORMAL.
+extern power_tier_t powerTier;
+
+power_tier_t getPowerTier(uint32_t batVoltage);
+unsigned long wifiTimeout();
+unsigned httpTimeout();
+int tierSleepInterval(int sleepInterval);
+
+#endif
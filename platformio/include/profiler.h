@@ -0,0 +1,113 @@
+/* Wake cycle profiler declarations for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include <Arduino.h>
+#include "config.h"
+
+/* The phases of a wake cycle. Time is charged to the innermost phase only, so
+ * a phase nested in another (ex. BUSY in REFRESH) is not counted twice and the
+ * phases of a cycle add up to the time spent awake.
+ */
+typedef enum profile_phase
+{
+  PROF_BME,         // indoor sensor power-up and read
+  PROF_WIFI,        // WiFi association and DHCP
+  PROF_SNTP,        // waiting for time synchronization
+  PROF_DNS,         // host name lookups
+  PROF_CONNECT,     // TCP connect and TLS handshake
+  PROF_FIRST_BYTE,  // request sent until the response headers are read
+  PROF_BODY_READ,   // waiting on the socket for the response body
+  PROF_JSON_PARSE,  // decoding (chunked, inflate) and deserializing the body
+  PROF_EPD_INIT,    // display power-up and initialization
+  PROF_DRAW_CURRENT,
+  PROF_DRAW_OUTLOOK,
+  PROF_DRAW_FORECAST,
+  PROF_DRAW_LOCATION,
+  PROF_DRAW_ALERTS,
+  PROF_DRAW_STATUS,
+  PROF_DRAW_INDOOR,
+  PROF_REFRESH,     // transferring pages and driving the panel refresh
+  PROF_BUSY,        // waiting on the BUSY line of the display
+  PROF_EPD_OFF,     // display hibernation
+  PROF_SLEEP_ENTRY, // preparing for deep sleep
+  PROF_NUM_PHASES
+} profile_phase_t;
+
+#if PHASE_PROFILING
+
+/* Phase times of one wake cycle, microseconds.
+ */
+typedef struct profile_cycle
+{
+  uint32_t phase_us[PROF_NUM_PHASES];
+  uint32_t awake_us;
+  uint16_t sleep_min; // refresh interval chosen for the following deep sleep
+} profile_cycle_t;
+
+/* Charges the time between its construction and end() (or destruction) to a
+ * phase. Scopes must end in the reverse order they were started.
+ */
+class ProfileScope
+{
+public:
+  explicit ProfileScope(profile_phase_t phase);
+  ~ProfileScope();
+  void end();
+
+private:
+  int8_t parent;
+  bool ended;
+};
+
+/* Stream adapter that charges the time spent reading from upstream to
+ * PROF_BODY_READ, and counts the bytes read.
+ */
+class ProfiledStream : public Stream
+{
+public:
+  explicit ProfiledStream(Stream &upstream);
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t readBytes(char *buffer, size_t length) override;
+  size_t write(uint8_t) override;
+  uint32_t bytesRead() const;
+
+private:
+  Stream &upstream;
+  uint32_t count;
+};
+
+void profileBusyCallback(const void *);
+const profile_cycle_t &finishProfile(int sleepInterval);
+uint32_t getProfileHistory(const profile_cycle_t *&cycles);
+const char *profilePhaseName(profile_phase_t phase);
+
+  #define PROFILE_SCOPE(phase)       ProfileScope profileScope(phase)
+  #define PROFILE_BEGIN(name, phase) ProfileScope name(phase)
+  #define PROFILE_END(name)          name.end()
+#else
+  #define PROFILE_SCOPE(phase)
+  #define PROFILE_BEGIN(name, phase)
+  #define PROFILE_END(name)
+#endif
+
+#endif
@@ -67,11 +67,12 @@ void drawMultiLnString(int16_t x, int16_t y, const String &text,
                        uint16_t color=GxEPD_BLACK);
 void initDisplay();
 void powerOffDisplay();
+bool displayNextPage();
 void drawCurrentConditions(const owm_current_t &current,
                            const owm_daily_t &today,
                            const owm_resp_air_pollution_t &owm_air_pollution);
 void drawForecast(const owm_daily_t *daily, tm timeInfo);
-void drawAlerts(std::vector<owm_alerts_t> &alerts,
+void drawAlerts(owm_resp_alerts_t &alerts,
                 const String &city, const String &date);
 void drawLocationDate(const String &city, const String &date);
 void drawOutlookGraph(const owm_hourly_t *hourly, const owm_daily_t *daily,
@@ -84,6 +85,10 @@ void drawCurrentSunrise(const owm_current_t &current);
 void drawCurrentSunset(const owm_current_t &current);
 void drawCurrentInTemp(float inTemp);
 void drawCurrentInHumidity(float inHumidity);
+void refreshCurrentInTemp(float inTemp);
+void refreshCurrentInHumidity(float inHumidity);
+void drawCurrentInIaq(int inIaq);
+void refreshCurrentInIaq(int inIaq);
 void drawCurrentMoonrise(const owm_daily_t &today);
 void drawCurrentMoonset(const owm_daily_t &today);
 void drawCurrentWind(const owm_current_t &current);
@@ -0,0 +1,61 @@
+/* Telemetry declarations for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+#include <Arduino.h>
+#include "config.h"
+#include "profiler.h"
+
+typedef enum telemetry_refresh
+{
+  REFRESH_SKIPPED,
+  REFRESH_PARTIAL,
+  REFRESH_FULL
+} telemetry_refresh_t;
+
+/* What happened during one wake cycle.
+ */
+typedef struct telemetry_record
+{
+  uint32_t time;        // Unix time at the end of the cycle, 0 if never set
+  uint32_t rx_bytes;    // response bytes received, before decompression
+  uint16_t awake_ms;
+  uint16_t battery_mv;
+  int16_t http_status;  // of the last request, see getHttpResponsePhrase
+  uint8_t wake_reason;  // esp_sleep_wakeup_cause_t
+  uint8_t parse_error;  // DeserializationError::Code of the last request
+  int8_t rssi;          // dBm, 0 if WiFi did not connect
+  uint8_t refresh;      // telemetry_refresh_t
+  uint16_t phase_ms[PROF_NUM_PHASES];
+} telemetry_record_t;
+
+#if TELEMETRY
+// The record of this wake cycle, filled in as the cycle goes.
+extern telemetry_record_t telemetry;
+
+void beginTelemetry();
+void commitTelemetry(const profile_cycle_t *cycle);
+void setTelemetryRefresh(telemetry_refresh_t refresh);
+void printTelemetry(Print &out, uint32_t fromSeq);
+uint32_t telemetryCount();
+uint32_t telemetryUploaded();
+void setTelemetryUploaded(uint32_t seq);
+#endif
+
+#endif
@@ -22,7 +22,7 @@
 #include <stddef.h>
 
 #ifndef AQI_EXTERN_TXT
-const char *AUSTRALIA_AQI_TXT[6] =
+const char *const AUSTRALIA_AQI_TXT[6] =
 {
   "Very Good",
   "Good",
@@ -31,14 +31,14 @@ const char *AUSTRALIA_AQI_TXT[6] =
   "Very Poor",
   "Hazardous",
 };
-const char *CANADA_AQHI_TXT[4] =
+const char *const CANADA_AQHI_TXT[4] =
 {
   "Low",
   "Moderate",
   "High",
   "Very High",
 };
-const char *CHINA_AQI_TXT[6] =
+const char *const CHINA_AQI_TXT[6] =
 {
   "Excellent",
   "Good",
@@ -47,7 +47,7 @@ const char *CHINA_AQI_TXT[6] =
   "Heavily Polluted",
   "Severely Polluted",
 };
-const char *EUROPEAN_UNION_CAQI_TXT[5] =
+const char *const EUROPEAN_UNION_CAQI_TXT[5] =
 {
   "Very Low",
   "Low",
@@ -55,7 +55,7 @@ const char *EUROPEAN_UNION_CAQI_TXT[5] =
   "High",
   "Very High",
 };
-const char *HONG_KONG_AQHI_TXT[5] =
+const char *const HONG_KONG_AQHI_TXT[5] =
 {
   "Low",
   "Moderate",
@@ -63,7 +63,7 @@ const char *HONG_KONG_AQHI_TXT[5] =
   "Very High",
   "Hazardous",
 };
-const char *INDIA_AQI_TXT[6] =
+const char *const INDIA_AQI_TXT[6] =
 {
   "Good",
   "Satisfactory",
@@ -72,7 +72,7 @@ const char *INDIA_AQI_TXT[6] =
   "Very Poor",
   "Severe",
 };
-const char *SINGAPORE_PSI_TXT[5] =
+const char *const SINGAPORE_PSI_TXT[5] =
 {
   "Good",
   "Moderate",
@@ -80,21 +80,21 @@ const char *SINGAPORE_PSI_TXT[5] =
   "Very Unhealthy",
   "Hazardous",
 };
-const char *SOUTH_KOREA_CAI_TXT[4] =
+const char *const SOUTH_KOREA_CAI_TXT[4] =
 {
   "Good",
   "Medium",
   "Unhealthy",
   "Very Unhealthy",
 };
-const char *UNITED_KINGDOM_DAQI_TXT[4] =
+const char *const UNITED_KINGDOM_DAQI_TXT[4] =
 {
   "Low",
   "Moderate",
   "High",
   "Very High",
 };
-const char *UNITED_STATES_AQI_TXT[6] =
+const char *const UNITED_STATES_AQI_TXT[6] =
 {
   "Good",
   "Moderate",
@@ -104,16 +104,16 @@ const char *UNITED_STATES_AQI_TXT[6] =
   "Hazardous",
 };
 #else
-extern const char *AUSTRALIA_AQI_TXT[6];
-extern const char *CANADA_AQHI_TXT[4];
-extern const char *CHINA_AQI_TXT[6];
-extern const char *EUROPEAN_UNION_CAQI_TXT[5];
-extern const char *HONG_KONG_AQHI_TXT[5];
-extern const char *INDIA_AQI_TXT[6];
-extern const char *SINGAPORE_PSI_TXT[5];
-extern const char *SOUTH_KOREA_CAI_TXT[4];
-extern const char *UNITED_KINGDOM_DAQI_TXT[4];
-extern const char *UNITED_STATES_AQI_TXT[6];
+extern const char *const AUSTRALIA_AQI_TXT[6];
+extern const char *const CANADA_AQHI_TXT[4];
+extern const char *const CHINA_AQI_TXT[6];
+extern const char *const EUROPEAN_UNION_CAQI_TXT[5];
+extern const char *const HONG_KONG_AQHI_TXT[5];
+extern const char *const INDIA_AQI_TXT[6];
+extern const char *const SINGAPORE_PSI_TXT[5];
+extern const char *const SOUTH_KOREA_CAI_TXT[4];
+extern const char *const UNITED_KINGDOM_DAQI_TXT[4];
+extern const char *const UNITED_STATES_AQI_TXT[6];
 #endif // AQI_EXTERN_TXT
 
 int max(int a, int b) { return a >= b ? a : b; }
@@ -138,36 +138,307 @@ int compute_piecewise_aqi(float i_lo, float i_hi,
                              * (c - c_lo) + i_lo)));
 } // end compute_piecewise_aqi
 
+/* Concentration representation.
+ *
+ * With AQI_FIXED_POINT defined, concentrations are evaluated as integers in
+ * units of 1/AQI_FIXED_SCALE μg/m^3 (or ppm and ppb once converted for the US
+ * scale), so that targets without a floating point unit evaluate every
+ * piecewise scale with integer arithmetic. Otherwise they are floats.
+ *
+ * AQI_C converts a constant in natural units to the representation in use,
+ * AQI_CONC does the same for a float at run time.
+ *
+ * AQI_LE, AQI_LT and AQI_GE compare a concentration with a constant in natural
+ * units the way the float build does. A float concentration is compared with
+ * the double constant, so a concentration that is the float nearest to 0.2 is
+ * not <= 0.2. In fixed point a concentration equal to AQI_C(b) stands for the
+ * float nearest to b, and AQI_FLOAT_CMP(b) tells which side of b that is.
+ */
+#ifdef AQI_FIXED_POINT
+typedef int32_t aqi_conc_t;
+typedef int32_t aqi_bound_t;
+typedef int16_t aqi_index_t;
+
+// NaN and infinite concentrations are kept apart from the finite ones, which
+// saturate at +/-AQI_CONC_MAX
+#define AQI_CONC_NAN INT32_MAX
+#define AQI_CONC_INF (INT32_MAX - 1)
+#define AQI_CONC_MAX (INT32_MAX - 2)
+
+#define AQI_C(x) ((x) > (double)AQI_CONC_MAX / AQI_FIXED_SCALE ? AQI_CONC_INF \
+                  : (aqi_conc_t)((x) * AQI_FIXED_SCALE + 0.5))
+#define AQI_CONC(x) float_to_conc(x)
+
+#define AQI_FLOAT_CMP(b) (((float)(b) > (b)) - ((float)(b) < (b)))
+#define AQI_LE(c, b) ((c) < AQI_C(b) \
+                      || ((c) == AQI_C(b) && AQI_FLOAT_CMP(b) <= 0))
+#define AQI_LT(c, b) ((c) < AQI_C(b) \
+                      || ((c) == AQI_C(b) && AQI_FLOAT_CMP(b) < 0))
+#define AQI_GE(c, b) ((c) != AQI_CONC_NAN && !AQI_LT(c, b))
+
+/* Converts a concentration in natural units to fixed point, saturating at
+ * +/-AQI_CONC_MAX. NaN and +INFINITY map to AQI_CONC_NAN and AQI_CONC_INF.
+ */
+static aqi_conc_t float_to_conc(float x)
+{
+  if (isnan(x))
+  {
+    return AQI_CONC_NAN;
+  }
+  double v = (double)x * AQI_FIXED_SCALE;
+  if (v >= AQI_CONC_MAX)
+  {
+    return isinf(x) ? AQI_CONC_INF : AQI_CONC_MAX;
+  }
+  if (v <= -AQI_CONC_MAX)
+  {
+    return -AQI_CONC_MAX;
+  }
+  return (aqi_conc_t)lround(v);
+} // end float_to_conc
+
+/* Integer equivalent of compute_nepm_aqi.
+ */
+static int compute_nepm_fixed(aqi_conc_t std, aqi_conc_t c)
+{
+  if (c <= 0)
+  {
+    return 0;
+  }
+  // round half away from zero, like round()
+  return (int)((200 * (int64_t)c + std) / (2 * (int64_t)std));
+} // end compute_nepm_fixed
+
+/* Integer equivalent of compute_piecewise_aqi.
+ */
+static int compute_piecewise_fixed(int i_lo, int i_hi,
+                                   aqi_conc_t c_lo, aqi_conc_t c_hi,
+                                   aqi_conc_t c)
+{
+  int64_t num = (int64_t)(i_hi - i_lo) * ((int64_t)c - c_lo);
+  int64_t den = (int64_t)c_hi - c_lo;
+  if (num <= 0)
+  {
+    return i_lo;
+  }
+  // round half away from zero, like round()
+  return min(i_hi, i_lo + (int)((2 * num + den) / (2 * den)));
+} // end compute_piecewise_fixed
+
+/* Converts concentration c by the ratio mul/div and truncates the result to a
+ * multiple of 1/steps. This is the integer equivalent of
+ *   truncate_float(c * mul / div, log10(steps))
+ * NaN, infinite and saturated concentrations are returned unchanged.
+ */
+static aqi_conc_t convert_truncate(aqi_conc_t c, int64_t mul, int64_t div,
+                                   int32_t steps)
+{
+  if (c >= AQI_CONC_MAX || c <= -AQI_CONC_MAX)
+  {
+    return c;
+  }
+  int64_t n = (int64_t)c * mul * steps;
+  int64_t d = div * AQI_FIXED_SCALE;
+  int64_t q = n / d;
+  if (n % d != 0 && n < 0)
+  {
+    --q; // floor
+  }
+  return (aqi_conc_t)(q * (AQI_FIXED_SCALE / steps));
+} // end convert_truncate
+
+/* Integer equivalent of truncate_int, for a concentration converted by the
+ * ratio mul/div.
+ */
+static aqi_conc_t convert_truncate_int(aqi_conc_t c, int64_t mul, int64_t div)
+{
+  if (c >= AQI_CONC_INF)
+  {
+    return -AQI_CONC_MAX;
+  }
+  return convert_truncate(c, mul, div, 1);
+} // end convert_truncate_int
+#else
+typedef float  aqi_conc_t;
+typedef double aqi_bound_t;
+typedef float  aqi_index_t;
+#define AQI_C(x) (x)
+#define AQI_CONC(x) (x)
+#define AQI_LE(c, b) ((c) <= (b))
+#define AQI_LT(c, b) ((c) <  (b))
+#define AQI_GE(c, b) ((c) >= (b))
+
+/* Truncates x to an integer, like the (int) conversions the US scale was
+ * written with. Those convert NaN, infinite and out of range values to INT_MIN
+ * on the hosts the golden results were recorded on, which falls in the lowest
+ * band. Such values give -INFINITY here instead, with the same result and
+ * without the undefined behavior.
+ */
+static float truncate_int(double x)
+{
+  return fabs(x) < 2147483648.0 ? (float)trunc(x) : -INFINITY;
+} // end truncate_int
+#endif // AQI_FIXED_POINT
+
+/* Returns the NEPM index of concentration c for standard std. A NaN or
+ * infinite concentration gives 0, so it does not raise the index. This is what
+ * the (int) conversion of compute_nepm_aqi gave on the hosts the golden results
+ * were recorded on, where it converts them to INT_MIN.
+ */
+static int nepm_aqi(aqi_conc_t std, aqi_conc_t c)
+{
+#ifdef AQI_FIXED_POINT
+  if (c >= AQI_CONC_INF)
+  {
+    return 0;
+  }
+  return compute_nepm_fixed(std, c);
+#else
+  if (!isfinite(c))
+  {
+    return 0;
+  }
+  return compute_nepm_aqi(std, c);
+#endif
+} // end nepm_aqi
+
+/* Breakpoint table support.
+ *
+ * Each scale below describes its piecewise linear sub-indices as a table of
+ * breakpoints sorted by ascending upper bound. The band for a concentration
+ * is found by a binary search on the upper bounds, then the sub-index is
+ * interpolated by compute_piecewise_aqi.
+ *
+ * In floating point, upper bounds are stored as double so that comparisons
+ * against bounds like 40.5 or 0.054 behave exactly like the double literals
+ * they were written as. In fixed point each bound keeps AQI_FLOAT_CMP of its
+ * literal, so a concentration equal to the bound falls in the same band as the
+ * float nearest to it does.
+ * Some scales state their bands as half-open intervals (c < bound) while
+ * others are closed (c <= bound), this is recorded per table.
+ */
+#define AQI_INCLUSIVE 0 // band applies while c <= bound
+#define AQI_EXCLUSIVE 1 // band applies while c <  bound
+
+typedef struct aqi_breakpoint
+{
+  aqi_bound_t bound;
+  aqi_conc_t c_lo, c_hi;
+  aqi_index_t i_lo, i_hi;
+#ifdef AQI_FIXED_POINT
+  int8_t bound_cmp;
+#endif
+} aqi_breakpoint_t;
+
+#ifdef AQI_FIXED_POINT
+#define AQI_BP(bound, c_lo, c_hi, i_lo, i_hi) \
+  { AQI_C(bound), AQI_C(c_lo), AQI_C(c_hi), i_lo, i_hi, AQI_FLOAT_CMP(bound) }
+#else
+#define AQI_BP(bound, c_lo, c_hi, i_lo, i_hi) \
+  { AQI_C(bound), AQI_C(c_lo), AQI_C(c_hi), i_lo, i_hi }
+#endif
+
+typedef struct aqi_table
+{
+  const aqi_breakpoint_t *bp;
+  int len;
+  int exclusive;
+} aqi_table_t;
+
+#define AQI_TABLE(bp, mode) { bp, sizeof(bp) / sizeof((bp)[0]), mode }
+
+/* Returns the sub-index of concentration c using the breakpoints in table t,
+ * or overflow if c is above the last band, NaN or +INFINITY.
+ */
+static int table_aqi(const aqi_table_t *t, aqi_conc_t c, int overflow)
+{
+#ifdef AQI_FIXED_POINT
+  if (c >= AQI_CONC_INF)
+  {
+    return overflow;
+  }
+#else
+  if (!isfinite(c))
+  {
+    return c < 0 ? t->bp[0].i_lo : overflow;
+  }
+#endif
+  int lo = 0;
+  int hi = t->len;
+  while (lo < hi)
+  {
+    int mid = (lo + hi) / 2;
+#ifdef AQI_FIXED_POINT
+    const aqi_breakpoint_t *b = &t->bp[mid];
+    int in_band = c < b->bound
+                  || (c == b->bound && (t->exclusive ? b->bound_cmp < 0
+                                                     : b->bound_cmp <= 0));
+#else
+    int in_band = t->exclusive ? c <  t->bp[mid].bound
+                               : c <= t->bp[mid].bound;
+#endif
+    if (in_band)
+    {
+      hi = mid;
+    }
+    else
+    {
+      lo = mid + 1;
+    }
+  }
+  if (lo == t->len)
+  {
+    return overflow;
+  }
+  const aqi_breakpoint_t *b = &t->bp[lo];
+#ifdef AQI_FIXED_POINT
+  return compute_piecewise_fixed(b->i_lo, b->i_hi, b->c_lo, b->c_hi, c);
+#else
+  return compute_piecewise_aqi(b->i_lo, b->i_hi, b->c_lo, b->c_hi, c);
+#endif
+} // end table_aqi
+
+
 /* Australia (AQI)
  *
  * References:
  *   https://www.environment.nsw.gov.au/topics/air/understanding-air-quality-data/air-quality-categories/history-of-air-quality-reporting/about-the-air-quality-index
  */
-int australia_aqi(float co_8h,  float no2_1h,   float o3_1h, float o3_4h,
-                  float so2_1h, float pm10_24h, float pm2_5_24h)
+static int australia_aqi_conc(aqi_conc_t co_8h, aqi_conc_t no2_1h,
+                              aqi_conc_t o3_1h, aqi_conc_t o3_4h,
+                              aqi_conc_t so2_1h, aqi_conc_t pm10_24h,
+                              aqi_conc_t pm2_5_24h)
 {
   int aqi = 0;
 
   // co    μg/m^3, Carbon Monoxide (CO)
   // standard = 9.0ppm * 1000ppb * 1.1456 μg/m^3 = 10310.4
-  aqi = max(aqi, compute_nepm_aqi(10310.4, co_8h));
+  aqi = max(aqi, nepm_aqi(AQI_C(10310.4), co_8h));
   // no2   μg/m^3, Nitrogen Dioxide (NO2)
   // standard = 0.12ppm * 1000ppb * 1.8816 μg/m^3 = 225.792
-  aqi = max(aqi, compute_nepm_aqi(225.792, no2_1h));
+  aqi = max(aqi, nepm_aqi(AQI_C(225.792), no2_1h));
   // o3    μg/m^3, Ground-Level Ozone (O3)
   // standard = 0.10ppm * 1000ppb * 1.9632 μg/m^3 = 196.32
-  aqi = max(aqi, compute_nepm_aqi(196.32, o3_1h));
+  aqi = max(aqi, nepm_aqi(AQI_C(196.32), o3_1h));
   // standard = 0.08ppm * 1000ppb * 1.9632 μg/m^3 = 157.056
-  aqi = max(aqi, compute_nepm_aqi(157.056, o3_4h));
+  aqi = max(aqi, nepm_aqi(AQI_C(157.056), o3_4h));
   // so2   μg/m^3, Sulfur Dioxide (SO2)
   // standard = 0.20ppm * 1000ppb * 8.4744 μg/m^3 = 1694.88
-  aqi = max(aqi, compute_nepm_aqi(1694.88, so2_1h));
+  aqi = max(aqi, nepm_aqi(AQI_C(1694.88), so2_1h));
   // pm10  μg/m^3, Coarse Particulate Matter (<10μm)
-  aqi = max(aqi, compute_nepm_aqi(50, pm10_24h));
+  aqi = max(aqi, nepm_aqi(AQI_C(50), pm10_24h));
   // pm2_5 μg/m^3, Fine Particulate Matter (<2.5μm)
-  aqi = max(aqi, compute_nepm_aqi(25, pm2_5_24h));
+  aqi = max(aqi, nepm_aqi(AQI_C(25), pm2_5_24h));
 
   return aqi;
+} // end australia_aqi_conc
+
+int australia_aqi(float co_8h,  float no2_1h,   float o3_1h, float o3_4h,
+                  float so2_1h, float pm10_24h, float pm2_5_24h)
+{
+  return australia_aqi_conc(AQI_CONC(co_8h), AQI_CONC(no2_1h), AQI_CONC(o3_1h),
+                            AQI_CONC(o3_4h), AQI_CONC(so2_1h),
+                            AQI_CONC(pm10_24h), AQI_CONC(pm2_5_24h));
 } // end australia_aqi
 
 /* Canada (AQHI)
@@ -183,6 +454,121 @@ int canada_aqhi(float no2_3h, float o3_3h, float pm2_5_3h)
                                      + (exp(0.000487 * pm2_5_3h) - 1))));
 } // end canada_aqhi
 
+static const aqi_breakpoint_t CHINA_CO_1H_BP[] =
+{
+  AQI_BP(  5000,      0,   5000,   0,  50),
+  AQI_BP( 10000,   5000,  10000,  51, 100),
+  AQI_BP( 35000,  10000,  35000, 101, 150),
+  AQI_BP( 60000,  35000,  60000, 151, 200),
+  AQI_BP( 90000,  60000,  90000, 201, 300),
+  AQI_BP(120000,  90000, 120000, 301, 400),
+  AQI_BP(150000, 120000, 150000, 401, 500),
+};
+static const aqi_table_t CHINA_CO_1H = AQI_TABLE(CHINA_CO_1H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t CHINA_CO_24H_BP[] =
+{
+  AQI_BP( 2000,     0,  2000,   0,  50),
+  AQI_BP( 4000,  2000,  4000,  51, 100),
+  AQI_BP(14000,  4000, 14000, 101, 150),
+  AQI_BP(24000, 14000, 24000, 151, 200),
+  AQI_BP(36000, 24000, 36000, 201, 300),
+  AQI_BP(48000, 36000, 48000, 301, 400),
+  AQI_BP(60000, 48000, 60000, 401, 500),
+};
+static const aqi_table_t CHINA_CO_24H = AQI_TABLE(CHINA_CO_24H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t CHINA_NO2_1H_BP[] =
+{
+  AQI_BP(  100,    0,  100,   0,  50),
+  AQI_BP(  200,  100,  200,  51, 100),
+  AQI_BP(  700,  200,  700, 101, 150),
+  AQI_BP( 1200,  700, 1200, 151, 200),
+  AQI_BP( 2340, 1200, 2340, 201, 300),
+  AQI_BP( 3090, 2340, 3090, 301, 400),
+  AQI_BP( 3840, 3090, 3840, 401, 500),
+};
+static const aqi_table_t CHINA_NO2_1H = AQI_TABLE(CHINA_NO2_1H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t CHINA_NO2_24H_BP[] =
+{
+  AQI_BP(   40,   0,  40,   0,  50),
+  AQI_BP(   80,  40,  80,  51, 100),
+  AQI_BP(  180,  80, 180, 101, 150),
+  AQI_BP(  280, 180, 280, 151, 200),
+  AQI_BP(  565, 280, 565, 201, 300),
+  AQI_BP(  750, 565, 750, 301, 400),
+  AQI_BP(  940, 750, 940, 401, 500),
+};
+static const aqi_table_t CHINA_NO2_24H = AQI_TABLE(CHINA_NO2_24H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t CHINA_O3_1H_BP[] =
+{
+  AQI_BP(  160,    0,  160,   0,  50),
+  AQI_BP(  200,  160,  200,  51, 100),
+  AQI_BP(  300,  200,  300, 101, 150),
+  AQI_BP(  400,  300,  400, 151, 200),
+  AQI_BP(  800,  400,  800, 201, 300),
+  AQI_BP( 1000,  800, 1000, 301, 400),
+  AQI_BP( 1200, 1000, 1200, 401, 500),
+};
+static const aqi_table_t CHINA_O3_1H = AQI_TABLE(CHINA_O3_1H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t CHINA_O3_8H_BP[] =
+{
+  AQI_BP(     100,   0, 100,   0,  50),
+  AQI_BP(     160, 100, 160,  51, 100),
+  AQI_BP(     215, 160, 215, 101, 150),
+  AQI_BP(     265, 215, 265, 151, 200),
+  AQI_BP(INFINITY, 265, 800, 201, 300),
+};
+static const aqi_table_t CHINA_O3_8H = AQI_TABLE(CHINA_O3_8H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t CHINA_SO2_1H_BP[] =
+{
+  AQI_BP(     150,   0, 150,   0,  50),
+  AQI_BP(     500, 150, 500,  51, 100),
+  AQI_BP(     650, 500, 650, 101, 150),
+  AQI_BP(INFINITY, 650, 800, 151, 200),
+};
+static const aqi_table_t CHINA_SO2_1H = AQI_TABLE(CHINA_SO2_1H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t CHINA_SO2_24H_BP[] =
+{
+  AQI_BP(   50,    0,   50,   0,  50),
+  AQI_BP(  150,   50,  150,  51, 100),
+  AQI_BP(  475,  150,  475, 101, 150),
+  AQI_BP(  800,  475,  800, 151, 200),
+  AQI_BP( 1600,  800, 1600, 201, 300),
+  AQI_BP( 2100, 1600, 2100, 301, 400),
+  AQI_BP( 2620, 2100, 2620, 401, 500),
+};
+static const aqi_table_t CHINA_SO2_24H = AQI_TABLE(CHINA_SO2_24H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t CHINA_PM10_24H_BP[] =
+{
+  AQI_BP(   50,   0,  50,   0,  50),
+  AQI_BP(  150,  50, 150,  51, 100),
+  AQI_BP(  250, 150, 250, 101, 150),
+  AQI_BP(  350, 250, 350, 151, 200),
+  AQI_BP(  420, 350, 420, 201, 300),
+  AQI_BP(  500, 420, 500, 301, 400),
+  AQI_BP(  600, 500, 600, 401, 500),
+};
+static const aqi_table_t CHINA_PM10_24H = AQI_TABLE(CHINA_PM10_24H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t CHINA_PM2_5_24H_BP[] =
+{
+  AQI_BP(   35,   0,  35,   0,  50),
+  AQI_BP(   75,  35,  75,  51, 100),
+  AQI_BP(  115,  75, 115, 101, 150),
+  AQI_BP(  150, 115, 150, 151, 200),
+  AQI_BP(  250, 150, 250, 201, 300),
+  AQI_BP(  350, 250, 350, 301, 400),
+  AQI_BP(  500, 350, 500, 401, 500),
+};
+static const aqi_table_t CHINA_PM2_5_24H = AQI_TABLE(CHINA_PM2_5_24H_BP, AQI_INCLUSIVE);
+
 /* China (AQI)
  *
  * References:
@@ -190,708 +576,134 @@ int canada_aqhi(float no2_3h, float o3_3h, float pm2_5_3h)
  *   https://en.wikipedia.org/wiki/Air_quality_index#Mainland_China
  *   https://datadrivenlab.org/air-quality-2/chinas-new-air-quality-index-how-does-it-measure-up/
  */
-int china_aqi(float co_1h, float co_24h, float no2_1h, float no2_24h,
-              float o3_1h, float o3_8h,  float so2_1h, float so2_24h,
-              float pm10_24h, float pm2_5_24h)
+static int china_aqi_conc(aqi_conc_t co_1h, aqi_conc_t co_24h,
+                          aqi_conc_t no2_1h, aqi_conc_t no2_24h,
+                          aqi_conc_t o3_1h, aqi_conc_t o3_8h, aqi_conc_t so2_1h,
+                          aqi_conc_t so2_24h, aqi_conc_t pm10_24h,
+                          aqi_conc_t pm2_5_24h)
 {
+  const int overflow = 501; // index > 500
   int aqi = 0;
-  float i_lo, i_hi;
-  float c_lo, c_hi;
 
   // co    μg/m^3, Carbon Monoxide (CO)
   // 1mg/m^3 = 1000 μg/m^3
-  if (co_1h <= 5000)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 5000;
-  }
-  else if (co_1h <= 10000)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 5000;
-    c_hi = 10000;
-  }
-  else if (co_1h <= 35000)
-  {
-    i_lo = 101;
-    i_hi = 150;
-    c_lo = 10000;
-    c_hi = 35000;
-  }
-  else if (co_1h <= 60000)
-  {
-    i_lo = 151;
-    i_hi = 200;
-    c_lo = 35000;
-    c_hi = 60000;
-  }
-  else if (co_1h <= 90000)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 60000;
-    c_hi = 90000;
-  }
-  else if (co_1h <= 120000)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 90000;
-    c_hi = 120000;
-  }
-  else if (co_1h <= 150000)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 120000;
-    c_hi = 150000;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, co_1h));
-
-  if (co_24h <= 2000)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 2000;
-  }
-  else if (co_24h <= 4000)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 2000;
-    c_hi = 4000;
-  }
-  else if (co_24h <= 14000)
-  {
-    i_lo = 101;
-    i_hi = 150;
-    c_lo = 4000;
-    c_hi = 14000;
-  }
-  else if (co_24h <= 24000)
-  {
-    i_lo = 151;
-    i_hi = 200;
-    c_lo = 14000;
-    c_hi = 24000;
-  }
-  else if (co_24h <= 36000)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 24000;
-    c_hi = 36000;
-  }
-  else if (co_24h <= 48000)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 36000;
-    c_hi = 48000;
-  }
-  else if (co_24h <= 60000)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 48000;
-    c_hi = 60000;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, co_24h));
+  aqi = max(aqi, table_aqi(&CHINA_CO_1H, co_1h, overflow));
+  aqi = max(aqi, table_aqi(&CHINA_CO_24H, co_24h, overflow));
 
   // no2   μg/m^3, Nitrogen Dioxide (NO2)
-  if (no2_1h <= 100)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 100;
-  }
-  else if (no2_1h <= 200)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 100;
-    c_hi = 200;
-  }
-  else if (no2_1h <= 700)
-  {
-    i_lo = 101;
-    i_hi = 150;
-    c_lo = 200;
-    c_hi = 700;
-  }
-  else if (no2_1h <= 1200)
-  {
-    i_lo = 151;
-    i_hi = 200;
-    c_lo = 700;
-    c_hi = 1200;
-  }
-  else if (no2_1h <= 2340)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 1200;
-    c_hi = 2340;
-  }
-  else if (no2_1h <= 3090)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 2340;
-    c_hi = 3090;
-  }
-  else if (no2_1h <= 3840)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 3090;
-    c_hi = 3840;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, no2_1h));
-
-  if (no2_24h <= 40)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 40;
-  }
-  else if (no2_24h <= 80)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 40;
-    c_hi = 80;
-  }
-  else if (no2_24h <= 180)
-  {
-    i_lo = 101;
-    i_hi = 150;
-    c_lo = 80;
-    c_hi = 180;
-  }
-  else if (no2_24h <= 280)
-  {
-    i_lo = 151;
-    i_hi = 200;
-    c_lo = 180;
-    c_hi = 280;
-  }
-  else if (no2_24h <= 565)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 280;
-    c_hi = 565;
-  }
-  else if (no2_24h <= 750)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 565;
-    c_hi = 750;
-  }
-  else if (no2_24h <= 940)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 750;
-    c_hi = 940;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, no2_24h));
+  aqi = max(aqi, table_aqi(&CHINA_NO2_1H, no2_1h, overflow));
+  aqi = max(aqi, table_aqi(&CHINA_NO2_24H, no2_24h, overflow));
 
   // o3    μg/m^3, Ozone (O3)
-  if (o3_1h <= 160)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 160;
-  }
-  else if (o3_1h <= 200)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 160;
-    c_hi = 200;
-  }
-  else if (o3_1h <= 300)
-  {
-    i_lo = 101;
-    i_hi = 150;
-    c_lo = 200;
-    c_hi = 300;
-  }
-  else if (o3_1h <= 400)
-  {
-    i_lo = 151;
-    i_hi = 200;
-    c_lo = 300;
-    c_hi = 400;
-  }
-  else if (o3_1h <= 800)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 400;
-    c_hi = 800;
-  }
-  else if (o3_1h <= 1000)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 800;
-    c_hi = 1000;
-  }
-  else if (o3_1h <= 1200)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 1000;
-    c_hi = 1200;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, o3_1h));
-
+  aqi = max(aqi, table_aqi(&CHINA_O3_1H, o3_1h, overflow));
   // If 8 hour average of o3 is > 800 μg/m^3 don't calculate it.
-  if (o3_8h <= 800)
+  if (AQI_LE(o3_8h, 800))
   {
-    if (o3_8h <= 100)
-    {
-      i_lo = 0;
-      i_hi = 50;
-      c_lo = 0;
-      c_hi = 100;
-    }
-    else if (o3_8h <= 160)
-    {
-      i_lo = 51;
-      i_hi = 100;
-      c_lo = 100;
-      c_hi = 160;
-    }
-    else if (o3_8h <= 215)
-    {
-      i_lo = 101;
-      i_hi = 150;
-      c_lo = 160;
-      c_hi = 215;
-    }
-    else if (o3_8h <= 265)
-    {
-      i_lo = 151;
-      i_hi = 200;
-      c_lo = 215;
-      c_hi = 265;
-    }
-    else
-    {
-      // 265 < o3_8h <= 800
-      i_lo = 201;
-      i_hi = 300;
-      c_lo = 265;
-      c_hi = 800;
-    }
-    aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, o3_8h));
+    aqi = max(aqi, table_aqi(&CHINA_O3_8H, o3_8h, overflow));
   }
 
   // so2   μg/m^3, Sulfur Dioxide (SO2)
   // If 1 hour average of so2 is > 800 μg/m^3 don't calculate it.
-  if (so2_1h <= 800)
+  if (AQI_LE(so2_1h, 800))
   {
-    if (so2_1h <= 150)
-    {
-      i_lo = 0;
-      i_hi = 50;
-      c_lo = 0;
-      c_hi = 150;
-    }
-    else if (so2_1h <= 500)
-    {
-      i_lo = 51;
-      i_hi = 100;
-      c_lo = 150;
-      c_hi = 500;
-    }
-    else if (so2_1h <= 650)
-    {
-      i_lo = 101;
-      i_hi = 150;
-      c_lo = 500;
-      c_hi = 650;
-    }
-    else
-    {
-      // 650 < so2_1h <= 800
-      i_lo = 151;
-      i_hi = 200;
-      c_lo = 650;
-      c_hi = 800;
-    }
-    aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, so2_1h));
+    aqi = max(aqi, table_aqi(&CHINA_SO2_1H, so2_1h, overflow));
   }
-
-  if (so2_24h <= 50)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 50;
-  }
-  else if (so2_24h <= 150)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 50;
-    c_hi = 150;
-  }
-  else if (so2_24h <= 475)
-  {
-    i_lo = 101;
-    i_hi = 150;
-    c_lo = 150;
-    c_hi = 475;
-  }
-  else if (so2_24h <= 800)
-  {
-    i_lo = 151;
-    i_hi = 200;
-    c_lo = 475;
-    c_hi = 800;
-  }
-  else if (so2_24h <= 1600)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 800;
-    c_hi = 1600;
-  }
-  else if (so2_24h <= 2100)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 1600;
-    c_hi = 2100;
-  }
-  else if (so2_24h <= 2620)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 2100;
-    c_hi = 2620;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, so2_24h));
+  aqi = max(aqi, table_aqi(&CHINA_SO2_24H, so2_24h, overflow));
 
   // pm10  μg/m^3, Coarse Particulate Matter (<10μm)
-  if (pm10_24h <= 50)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 50;
-  }
-  else if (pm10_24h <= 150)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 50;
-    c_hi = 150;
-  }
-  else if (pm10_24h <= 250)
-  {
-    i_lo = 101;
-    i_hi = 150;
-    c_lo = 150;
-    c_hi = 250;
-  }
-  else if (pm10_24h <= 350)
-  {
-    i_lo = 151;
-    i_hi = 200;
-    c_lo = 250;
-    c_hi = 350;
-  }
-  else if (pm10_24h <= 420)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 350;
-    c_hi = 420;
-  }
-  else if (pm10_24h <= 500)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 420;
-    c_hi = 500;
-  }
-  else if (pm10_24h <= 600)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 500;
-    c_hi = 600;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, pm10_24h));
+  aqi = max(aqi, table_aqi(&CHINA_PM10_24H, pm10_24h, overflow));
 
   // pm2_5 μg/m^3, Fine Particulate Matter (<2.5μm)
-  if (pm2_5_24h <= 35)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 35;
-  }
-  else if (pm2_5_24h <= 75)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 35;
-    c_hi = 75;
-  }
-  else if (pm2_5_24h <= 115)
-  {
-    i_lo = 101;
-    i_hi = 150;
-    c_lo = 75;
-    c_hi = 115;
-  }
-  else if (pm2_5_24h <= 150)
-  {
-    i_lo = 151;
-    i_hi = 200;
-    c_lo = 115;
-    c_hi = 150;
-  }
-  else if (pm2_5_24h <= 250)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 150;
-    c_hi = 250;
-  }
-  else if (pm2_5_24h <= 350)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 250;
-    c_hi = 350;
-  }
-  else if (pm2_5_24h <= 500)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 350;
-    c_hi = 500;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, pm2_5_24h));
+  aqi = max(aqi, table_aqi(&CHINA_PM2_5_24H, pm2_5_24h, overflow));
 
   return aqi;
+} // end china_aqi_conc
+
+int china_aqi(float co_1h, float co_24h, float no2_1h, float no2_24h,
+              float o3_1h, float o3_8h,  float so2_1h, float so2_24h,
+              float pm10_24h, float pm2_5_24h)
+{
+  return china_aqi_conc(AQI_CONC(co_1h), AQI_CONC(co_24h), AQI_CONC(no2_1h),
+                        AQI_CONC(no2_24h), AQI_CONC(o3_1h), AQI_CONC(o3_8h),
+                        AQI_CONC(so2_1h), AQI_CONC(so2_24h), AQI_CONC(pm10_24h),
+                        AQI_CONC(pm2_5_24h));
 } // end china_aqi
 
+static const aqi_breakpoint_t EU_NO2_1H_BP[] =
+{
+  AQI_BP(   50,   0,  50,  0,  25),
+  AQI_BP(  100,  50, 100, 26,  50),
+  AQI_BP(  200, 100, 200, 51,  75),
+  AQI_BP(  400, 200, 400, 76, 100),
+};
+static const aqi_table_t EU_NO2_1H = AQI_TABLE(EU_NO2_1H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t EU_O3_1H_BP[] =
+{
+  AQI_BP(   60,   0,  60,  0,  25),
+  AQI_BP(  120,  60, 120, 25,  50),
+  AQI_BP(  180, 120, 180, 51,  75),
+  AQI_BP(  240, 180, 240, 76, 100),
+};
+static const aqi_table_t EU_O3_1H = AQI_TABLE(EU_O3_1H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t EU_PM10_1H_BP[] =
+{
+  AQI_BP(   25,  0,  25,  0,  25),
+  AQI_BP(   50, 25,  50, 26,  50),
+  AQI_BP(   90, 50,  90, 51,  75),
+  AQI_BP(  180, 90, 180, 76, 100),
+};
+static const aqi_table_t EU_PM10_1H = AQI_TABLE(EU_PM10_1H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t EU_PM2_5_1H_BP[] =
+{
+  AQI_BP(   15,  0,  15,  0,  25),
+  AQI_BP(   30, 15,  30, 26,  50),
+  AQI_BP(   55, 30,  55, 51,  75),
+  AQI_BP(  110, 55, 110, 76, 100),
+};
+static const aqi_table_t EU_PM2_5_1H = AQI_TABLE(EU_PM2_5_1H_BP, AQI_INCLUSIVE);
+
 /* European Union (CAQI)
  *
  * References:
  *   http://airqualitynow.eu/about_indices_definition.php
  *   https://en.wikipedia.org/wiki/Air_quality_index#CAQI
  */
-int european_union_caqi(float no2_1h, float o3_1h, float pm10_1h, float pm2_5_1h)
+static int european_union_caqi_conc(aqi_conc_t no2_1h, aqi_conc_t o3_1h,
+                                    aqi_conc_t pm10_1h, aqi_conc_t pm2_5_1h)
 {
+  const int overflow = 101; // index > 100
   int caqi = 0;
-  float i_lo, i_hi;
-  float c_lo, c_hi;
 
   // no2   μg/m^3, Nitrogen Dioxide (NO2)
-  if (no2_1h <= 50)
-  {
-    i_lo = 0;
-    i_hi = 25;
-    c_lo = 0;
-    c_hi = 50;
-  }
-  else if (no2_1h <= 100)
-  {
-    i_lo = 26;
-    i_hi = 50;
-    c_lo = 50;
-    c_hi = 100;
-  }
-  else if (no2_1h <= 200)
-  {
-    i_lo = 51;
-    i_hi = 75;
-    c_lo = 100;
-    c_hi = 200;
-  }
-  else if (no2_1h <= 400)
-  {
-    i_lo = 76;
-    i_hi = 100;
-    c_lo = 200;
-    c_hi = 400;
-  }
-  else
-  {
-    // index > 100
-    return 101;
-  }
-  caqi = max(caqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, no2_1h));
+  caqi = max(caqi, table_aqi(&EU_NO2_1H, no2_1h, overflow));
 
   // o3    μg/m^3, Ground-Level Ozone (O3)
-  if (o3_1h <= 60)
-  {
-    i_lo = 0;
-    i_hi = 25;
-    c_lo = 0;
-    c_hi = 60;
-  }
-  else if (o3_1h <= 120)
-  {
-    i_lo = 25;
-    i_hi = 50;
-    c_lo = 60;
-    c_hi = 120;
-  }
-  else if (o3_1h <= 180)
-  {
-    i_lo = 51;
-    i_hi = 75;
-    c_lo = 120;
-    c_hi = 180;
-  }
-  else if (o3_1h <= 240)
-  {
-    i_lo = 76;
-    i_hi = 100;
-    c_lo = 180;
-    c_hi = 240;
-  }
-  else
-  {
-    // index > 100
-    return 101;
-  }
-  caqi = max(caqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, o3_1h));
+  caqi = max(caqi, table_aqi(&EU_O3_1H, o3_1h, overflow));
 
   // pm10  μg/m^3, Coarse Particulate Matter (<10μm)
-  if (pm10_1h <= 25)
-  {
-    i_lo = 0;
-    i_hi = 25;
-    c_lo = 0;
-    c_hi = 25;
-  }
-  else if (pm10_1h <= 50)
-  {
-    i_lo = 26;
-    i_hi = 50;
-    c_lo = 25;
-    c_hi = 50;
-  }
-  else if (pm10_1h <= 90)
-  {
-    i_lo = 51;
-    i_hi = 75;
-    c_lo = 50;
-    c_hi = 90;
-  }
-  else if (pm10_1h <= 180)
-  {
-    i_lo = 76;
-    i_hi = 100;
-    c_lo = 90;
-    c_hi = 180;
-  }
-  else
-  {
-    // index > 100
-    return 101;
-  }
-  caqi = max(caqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, pm10_1h));
+  caqi = max(caqi, table_aqi(&EU_PM10_1H, pm10_1h, overflow));
 
   // pm2_5 μg/m^3, Fine Particulate Matter (<2.5μm)
-  if (pm2_5_1h <= 15)
-  {
-    i_lo = 0;
-    i_hi = 25;
-    c_lo = 0;
-    c_hi = 15;
-  }
-  else if (pm2_5_1h <= 30)
-  {
-    i_lo = 26;
-    i_hi = 50;
-    c_lo = 15;
-    c_hi = 30;
-  }
-  else if (pm2_5_1h <= 55)
-  {
-    i_lo = 51;
-    i_hi = 75;
-    c_lo = 30;
-    c_hi = 55;
-  }
-  else if (pm2_5_1h <= 110)
-  {
-    i_lo = 76;
-    i_hi = 100;
-    c_lo = 55;
-    c_hi = 110;
-  }
-  else
-  {
-    // index > 100
-    return 101;
-  }
-  caqi = max(caqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, pm2_5_1h));
+  caqi = max(caqi, table_aqi(&EU_PM2_5_1H, pm2_5_1h, overflow));
 
   return caqi;
+} // end european_union_caqi_conc
+
+int european_union_caqi(float no2_1h, float o3_1h, float pm10_1h, float pm2_5_1h)
+{
+  return european_union_caqi_conc(AQI_CONC(no2_1h), AQI_CONC(o3_1h),
+                                  AQI_CONC(pm10_1h), AQI_CONC(pm2_5_1h));
 } // end european_union_caqi
 
+// Upper bound of added health risk (%AR) for AQHI 1 through 10.
+static const double HONG_KONG_AR_BOUNDS[] =
+{
+  1.88, 3.76, 5.64, 7.52, 9.41, 11.29, 12.91, 15.07, 17.22, 19.37,
+};
+
 /* Hong Kong (AQHI)
  *
  * References:
@@ -902,993 +714,444 @@ int hong_kong_aqhi(float no2_3h,  float o3_3h, float so2_3h,
                    float pm10_3h, float pm2_5_3h)
 {
   float ar = ((exp(0.0004462559 * no2_3h) - 1) * 100) + ((exp(0.0001393235 * so2_3h) - 1) * 100) + ((exp(0.0005116328 * o3_3h) - 1) * 100) + fmax(((exp(0.0002821751 * pm10_3h) - 1) * 100), ((exp(0.0002180567 * pm2_5_3h) - 1) * 100));
-  if (ar <= 1.88)
-  {
-    return 1;
-  }
-  else if (ar <= 3.76)
-  {
-    return 2;
-  }
-  else if (ar <= 5.64)
-  {
-    return 3;
-  }
-  else if (ar <= 7.52)
-  {
-    return 4;
-  }
-  else if (ar <= 9.41)
-  {
-    return 5;
-  }
-  else if (ar <= 11.29)
-  {
-    return 6;
-  }
-  else if (ar <= 12.91)
-  {
-    return 7;
-  }
-  else if (ar <= 15.07)
-  {
-    return 8;
-  }
-  else if (ar <= 17.22)
-  {
-    return 9;
-  }
-  else if (ar <= 19.37)
-  {
-    return 10;
-  }
-  else
-  {
-    // index > 10
-    return 11;
+  // index of the first band whose upper bound is >= ar, index > 10 if none
+  const int len = sizeof(HONG_KONG_AR_BOUNDS) / sizeof(HONG_KONG_AR_BOUNDS[0]);
+  int lo = 0;
+  int hi = len;
+  while (lo < hi)
+  {
+    int mid = (lo + hi) / 2;
+    if (ar <= HONG_KONG_AR_BOUNDS[mid])
+    {
+      hi = mid;
+    }
+    else
+    {
+      lo = mid + 1;
+    }
   }
+  return lo + 1;
 } // end hong_kong_aqhi
 
+static const aqi_breakpoint_t INDIA_CO_8H_BP[] =
+{
+  AQI_BP( 1050,     0,  1000,   0,  50),
+  AQI_BP( 2050,  1100,  2000,  51, 100),
+  AQI_BP(10050,  2100, 10000, 101, 200),
+  AQI_BP(17050, 10100, 17000, 201, 300),
+  AQI_BP(34050, 17100, 34000, 301, 400),
+};
+static const aqi_table_t INDIA_CO_8H = AQI_TABLE(INDIA_CO_8H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t INDIA_NH3_24H_BP[] =
+{
+  AQI_BP( 200.5,    0,  200,   0,  50),
+  AQI_BP( 400.5,  201,  400,  51, 100),
+  AQI_BP( 800.5,  401,  800, 101, 200),
+  AQI_BP(1200.5,  801, 1200, 201, 300),
+  AQI_BP(1800.5, 1201, 1800, 301, 400),
+};
+static const aqi_table_t INDIA_NH3_24H = AQI_TABLE(INDIA_NH3_24H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t INDIA_NO2_24H_BP[] =
+{
+  AQI_BP( 40.5,   0,  40,   0,  50),
+  AQI_BP( 80.5,  41,  80,  51, 100),
+  AQI_BP(180.5,  81, 180, 101, 200),
+  AQI_BP(280.5, 181, 280, 201, 300),
+  AQI_BP(400.5, 281, 400, 301, 400),
+};
+static const aqi_table_t INDIA_NO2_24H = AQI_TABLE(INDIA_NO2_24H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t INDIA_O3_8H_BP[] =
+{
+  AQI_BP( 50.5,   0,  50,   0,  50),
+  AQI_BP(100.5,  51, 100,  51, 100),
+  AQI_BP(168.5, 101, 168, 101, 200),
+  AQI_BP(208.5, 169, 208, 201, 300),
+  AQI_BP(748.5, 209, 748, 301, 400),
+};
+static const aqi_table_t INDIA_O3_8H = AQI_TABLE(INDIA_O3_8H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t INDIA_PB_24H_BP[] =
+{
+  AQI_BP( 0.55,   0, 0.5,   0,  50),
+  AQI_BP( 1.05, 0.6, 1.0,  51, 100),
+  AQI_BP( 2.05, 1.1, 2.0, 101, 200),
+  AQI_BP( 3.05, 2.1, 3.0, 201, 300),
+  AQI_BP( 3.55, 3.1, 3.5, 301, 400),
+};
+static const aqi_table_t INDIA_PB_24H = AQI_TABLE(INDIA_PB_24H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t INDIA_SO2_24H_BP[] =
+{
+  AQI_BP(  40.5,   0,   40,   0,  50),
+  AQI_BP(  80.5,  41,   80,  51, 100),
+  AQI_BP( 380.5,  81,  380, 101, 200),
+  AQI_BP( 800.5, 381,  800, 201, 300),
+  AQI_BP(1600.5, 801, 1600, 301, 400),
+};
+static const aqi_table_t INDIA_SO2_24H = AQI_TABLE(INDIA_SO2_24H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t INDIA_PM10_24H_BP[] =
+{
+  AQI_BP( 50.5,   0,  50,   0,  50),
+  AQI_BP(100.5,  51, 100,  51, 100),
+  AQI_BP(250.5, 101, 250, 101, 200),
+  AQI_BP(350.5, 251, 350, 201, 300),
+  AQI_BP(430.5, 351, 430, 301, 400),
+};
+static const aqi_table_t INDIA_PM10_24H = AQI_TABLE(INDIA_PM10_24H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t INDIA_PM2_5_24H_BP[] =
+{
+  AQI_BP( 30.5,   0,  30,   0,  50),
+  AQI_BP( 60.5,  31,  60,  51, 100),
+  AQI_BP( 90.5,  61,  90, 101, 200),
+  AQI_BP(120.5,  91, 120, 201, 300),
+  AQI_BP(250.5, 121, 250, 301, 400),
+};
+static const aqi_table_t INDIA_PM2_5_24H = AQI_TABLE(INDIA_PM2_5_24H_BP, AQI_EXCLUSIVE);
+
 /* India (AQI)
  *
  * References:
  *   https://www.aqi.in/blog/aqi/
  *   https://www.pranaair.com/blog/what-is-air-quality-index-aqi-and-its-calculation/
  */
-int india_aqi(float co_8h,  float nh3_24h, float no2_24h,  float o3_8h,
-              float pb_24h, float so2_24h, float pm10_24h, float pm2_5_24h)
+static int india_aqi_conc(aqi_conc_t co_8h, aqi_conc_t nh3_24h,
+                          aqi_conc_t no2_24h, aqi_conc_t o3_8h,
+                          aqi_conc_t pb_24h, aqi_conc_t so2_24h,
+                          aqi_conc_t pm10_24h, aqi_conc_t pm2_5_24h)
 {
+  const int overflow = 401; // index > 400
   int aqi = 0;
-  float i_lo, i_hi;
-  float c_lo, c_hi;
 
   // co    μg/m^3, Carbon Monoxide (CO)
   // 1mg/m^3 = 1000 μg/m^3
-  if (co_8h < 1050)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 1000;
-  }
-  else if (co_8h < 2050)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 1100;
-    c_hi = 2000;
-  }
-  else if (co_8h < 10050)
-  {
-    i_lo = 101;
-    i_hi = 200;
-    c_lo = 2100;
-    c_hi = 10000;
-  }
-  else if (co_8h < 17050)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 10100;
-    c_hi = 17000;
-  }
-  else if (co_8h < 34050)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 17100;
-    c_hi = 34000;
-  }
-  else
-  {
-    // index > 400
-    return 401;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, co_8h));
+  aqi = max(aqi, table_aqi(&INDIA_CO_8H, co_8h, overflow));
 
   // nh3   μg/m^3, Ammonia (NH3)
-  if (nh3_24h < 200.5)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 200;
-  }
-  else if (nh3_24h < 400.5)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 201;
-    c_hi = 400;
-  }
-  else if (nh3_24h < 800.5)
-  {
-    i_lo = 101;
-    i_hi = 200;
-    c_lo = 401;
-    c_hi = 800;
-  }
-  else if (nh3_24h < 1200.5)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 801;
-    c_hi = 1200;
-  }
-  else if (nh3_24h < 1800.5)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 1201;
-    c_hi = 1800;
-  }
-  else
-  {
-    // index > 400
-    return 401;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, nh3_24h));
+  aqi = max(aqi, table_aqi(&INDIA_NH3_24H, nh3_24h, overflow));
 
   // no2   μg/m^3, Nitrogen Dioxide (NO2)
-  if (no2_24h < 40.5)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 40;
-  }
-  else if (no2_24h < 80.5)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 41;
-    c_hi = 80;
-  }
-  else if (no2_24h < 180.5)
-  {
-    i_lo = 101;
-    i_hi = 200;
-    c_lo = 81;
-    c_hi = 180;
-  }
-  else if (no2_24h < 280.5)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 181;
-    c_hi = 280;
-  }
-  else if (no2_24h < 400.5)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 281;
-    c_hi = 400;
-  }
-  else
-  {
-    // index > 400
-    return 401;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, no2_24h));
+  aqi = max(aqi, table_aqi(&INDIA_NO2_24H, no2_24h, overflow));
 
   // o3    μg/m^3, Ozone (O3)
-  if (o3_8h < 50.5)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 50;
-  }
-  else if (o3_8h < 100.5)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 51;
-    c_hi = 100;
-  }
-  else if (o3_8h < 168.5)
-  {
-    i_lo = 101;
-    i_hi = 200;
-    c_lo = 101;
-    c_hi = 168;
-  }
-  else if (o3_8h < 208.5)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 169;
-    c_hi = 208;
-  }
-  else if (o3_8h < 748.5)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 209;
-    c_hi = 748;
-  }
-  else
-  {
-    // index > 400
-    return 401;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, o3_8h));
-
-  // pb    μg/m^3, Lead (Pb)
-  if (pb_24h < 0.55)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 0.5;
-  }
-  else if (pb_24h < 1.05)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 0.6;
-    c_hi = 1.0;
-  }
-  else if (pb_24h < 2.05)
-  {
-    i_lo = 101;
-    i_hi = 200;
-    c_lo = 1.1;
-    c_hi = 2.0;
-  }
-  else if (pb_24h < 3.05)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 2.1;
-    c_hi = 3.0;
-  }
-  else if (pb_24h < 3.55)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 3.1;
-    c_hi = 3.5;
-  }
-  else
-  {
-    // index > 400
-    return 401;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, pb_24h));
-
-  // so2   μg/m^3, Sulfur Dioxide (SO2)
-  if (so2_24h < 40.5)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 40;
-  }
-  else if (so2_24h < 80.5)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 41;
-    c_hi = 80;
-  }
-  else if (so2_24h < 380.5)
-  {
-    i_lo = 101;
-    i_hi = 200;
-    c_lo = 81;
-    c_hi = 380;
-  }
-  else if (so2_24h < 800.5)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 381;
-    c_hi = 800;
-  }
-  else if (so2_24h < 1600.5)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 801;
-    c_hi = 1600;
-  }
-  else
-  {
-    // index > 400
-    return 401;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, so2_24h));
+  aqi = max(aqi, table_aqi(&INDIA_O3_8H, o3_8h, overflow));
+
+  // pb    μg/m^3, Lead (Pb)
+  aqi = max(aqi, table_aqi(&INDIA_PB_24H, pb_24h, overflow));
+
+  // so2   μg/m^3, Sulfur Dioxide (SO2)
+  aqi = max(aqi, table_aqi(&INDIA_SO2_24H, so2_24h, overflow));
 
   // pm10  μg/m^3, Coarse Particulate Matter (<10μm)
-  if (pm10_24h < 50.5)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 50;
-  }
-  else if (pm10_24h < 100.5)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 51;
-    c_hi = 100;
-  }
-  else if (pm10_24h < 250.5)
-  {
-    i_lo = 101;
-    i_hi = 200;
-    c_lo = 101;
-    c_hi = 250;
-  }
-  else if (pm10_24h < 350.5)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 251;
-    c_hi = 350;
-  }
-  else if (pm10_24h < 430.5)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 351;
-    c_hi = 430;
-  }
-  else
-  {
-    // index > 400
-    return 401;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, pm10_24h));
+  aqi = max(aqi, table_aqi(&INDIA_PM10_24H, pm10_24h, overflow));
 
   // pm2_5 μg/m^3, Fine Particulate Matter (<2.5μm)
-  if (pm2_5_24h < 30.5)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 30;
-  }
-  else if (pm2_5_24h < 60.5)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 31;
-    c_hi = 60;
-  }
-  else if (pm2_5_24h < 90.5)
-  {
-    i_lo = 101;
-    i_hi = 200;
-    c_lo = 61;
-    c_hi = 90;
-  }
-  else if (pm2_5_24h < 120.5)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 91;
-    c_hi = 120;
-  }
-  else if (pm2_5_24h < 250.5)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 121;
-    c_hi = 250;
-  }
-  else
-  {
-    // index > 400
-    return 401;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, pm2_5_24h));
+  aqi = max(aqi, table_aqi(&INDIA_PM2_5_24H, pm2_5_24h, overflow));
 
   return aqi;
+} // end india_aqi_conc
+
+int india_aqi(float co_8h,  float nh3_24h, float no2_24h,  float o3_8h,
+              float pb_24h, float so2_24h, float pm10_24h, float pm2_5_24h)
+{
+  return india_aqi_conc(AQI_CONC(co_8h), AQI_CONC(nh3_24h), AQI_CONC(no2_24h),
+                        AQI_CONC(o3_8h), AQI_CONC(pb_24h), AQI_CONC(so2_24h),
+                        AQI_CONC(pm10_24h), AQI_CONC(pm2_5_24h));
 } // end india_aqi
 
+static const aqi_breakpoint_t SINGAPORE_CO_8H_BP[] =
+{
+  AQI_BP( 5050,     0,  5000,   0,  50),
+  AQI_BP(10050,  5100, 10000,  51, 100),
+  AQI_BP(17050, 10100, 17000, 101, 200),
+  AQI_BP(34050, 17100, 34000, 201, 300),
+  AQI_BP(46050, 34100, 46000, 301, 400),
+  AQI_BP(57550, 46100, 57500, 401, 500),
+};
+static const aqi_table_t SINGAPORE_CO_8H = AQI_TABLE(SINGAPORE_CO_8H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t SINGAPORE_NO2_1H_BP[] =
+{
+  AQI_BP(2260.5, 1131, 2260, 201, 300),
+  AQI_BP(3000.5, 2261, 3000, 301, 400),
+  AQI_BP(3750.5, 3001, 3750, 401, 500),
+};
+static const aqi_table_t SINGAPORE_NO2_1H = AQI_TABLE(SINGAPORE_NO2_1H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t SINGAPORE_O3_8H_BP[] =
+{
+  AQI_BP(   118.5,   0, 118,   0,  50),
+  AQI_BP(   157.5, 119, 157,  51, 100),
+  AQI_BP(   235.5, 158, 235, 101, 200),
+  AQI_BP(INFINITY, 236, 785, 201, 300),
+};
+static const aqi_table_t SINGAPORE_O3_8H = AQI_TABLE(SINGAPORE_O3_8H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t SINGAPORE_O3_1H_BP[] =
+{
+  AQI_BP( 118.5,   0,  118,   0,  50),
+  AQI_BP( 157.5, 119,  157,  51, 100),
+  AQI_BP( 235.5, 158,  235, 101, 200),
+  AQI_BP( 785.5, 236,  785, 201, 300),
+  AQI_BP( 980.5, 786,  980, 301, 400),
+  AQI_BP(1180.5, 981, 1180, 401, 500),
+};
+static const aqi_table_t SINGAPORE_O3_1H = AQI_TABLE(SINGAPORE_O3_1H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t SINGAPORE_SO2_24H_BP[] =
+{
+  AQI_BP(  80.5,    0,   80,   0,  50),
+  AQI_BP( 365.5,   81,  365,  51, 100),
+  AQI_BP( 800.5,  366,  800, 101, 200),
+  AQI_BP(1600.5,  801, 1600, 201, 300),
+  AQI_BP(2100.5, 1601, 2100, 301, 400),
+  AQI_BP(2620.5, 2101, 2620, 401, 500),
+};
+static const aqi_table_t SINGAPORE_SO2_24H = AQI_TABLE(SINGAPORE_SO2_24H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t SINGAPORE_PM10_24H_BP[] =
+{
+  AQI_BP( 50.5,   0,  50,   0,  50),
+  AQI_BP(150.5,  51, 150,  51, 100),
+  AQI_BP(350.5, 151, 350, 101, 200),
+  AQI_BP(420.5, 351, 420, 201, 300),
+  AQI_BP(500.5, 421, 500, 301, 400),
+  AQI_BP(600.5, 501, 600, 401, 500),
+};
+static const aqi_table_t SINGAPORE_PM10_24H = AQI_TABLE(SINGAPORE_PM10_24H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t SINGAPORE_PM2_5_24H_BP[] =
+{
+  AQI_BP( 12.5,   0,  12,   0,  50),
+  AQI_BP( 55.5,  13,  55,  51, 100),
+  AQI_BP(150.5,  56, 150, 101, 200),
+  AQI_BP(250.5, 151, 250, 201, 300),
+  AQI_BP(350.5, 251, 350, 301, 400),
+  AQI_BP(500.5, 351, 500, 401, 500),
+};
+static const aqi_table_t SINGAPORE_PM2_5_24H = AQI_TABLE(SINGAPORE_PM2_5_24H_BP, AQI_EXCLUSIVE);
+
 /* Singapore (PSI)
  *
  * References:
  *   https://www.haze.gov.sg/
  *   http://www.haze.gov.sg/docs/default-source/faq/computation-of-the-pollutant-standards-index-%28psi%29.pdf
  */
-int singapore_psi(float co_8h,   float no2_1h,   float o3_1h, float o3_8h,
-                  float so2_24h, float pm10_24h, float pm2_5_24h)
+static int singapore_psi_conc(aqi_conc_t co_8h, aqi_conc_t no2_1h,
+                              aqi_conc_t o3_1h, aqi_conc_t o3_8h,
+                              aqi_conc_t so2_24h, aqi_conc_t pm10_24h,
+                              aqi_conc_t pm2_5_24h)
 {
+  const int overflow = 501; // index > 500
   int psi = 0;
-  float i_lo, i_hi;
-  float c_lo, c_hi;
 
   // co    μg/m^3, Carbon Monoxide (CO)
   // 1mg/m^3 = 1000 μg/m^3
-  if (co_8h < 5050)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 5000;
-  }
-  else if (co_8h < 10050)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 5100;
-    c_hi = 10000;
-  }
-  else if (co_8h < 17050)
-  {
-    i_lo = 101;
-    i_hi = 200;
-    c_lo = 10100;
-    c_hi = 17000;
-  }
-  else if (co_8h < 34050)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 17100;
-    c_hi = 34000;
-  }
-  else if (co_8h < 46050)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 34100;
-    c_hi = 46000;
-  }
-  else if (co_8h < 57550)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 46100;
-    c_hi = 57500;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  psi = max(psi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, co_8h));
+  psi = max(psi, table_aqi(&SINGAPORE_CO_8H, co_8h, overflow));
 
   // no2   μg/m^3, Nitrogen Dioxide (NO2)
   // only calculated if >= 1130 μg/m^3
-  if (no2_1h >= 1129.5)
+  if (AQI_GE(no2_1h, 1129.5) && AQI_LT(no2_1h, 1130.5))
   {
-    if (no2_1h < 2260.5)
-    {
-      i_lo = 201;
-      i_hi = 300;
-      c_lo = 1131;
-      c_hi = 2260;
-    }
-    else if (no2_1h < 3000.5)
-    {
-      i_lo = 301;
-      i_hi = 400;
-      c_lo = 2261;
-      c_hi = 3000;
-    }
-    else if (no2_1h < 3750.5)
-    {
-      i_lo = 401;
-      i_hi = 500;
-      c_lo = 3001;
-      c_hi = 3750;
-    }
-    else
-    {
-      // index > 500
-      return 501;
-    }
-    if (no2_1h >= 1129.5 && no2_1h < 1130.5)
-    {
-      psi = max(psi, 200);
-    }
-    else
-    {
-      psi = max(psi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, no2_1h));
-    }
+    psi = max(psi, 200);
+  }
+  else if (AQI_GE(no2_1h, 1129.5))
+  {
+    psi = max(psi, table_aqi(&SINGAPORE_NO2_1H, no2_1h, overflow));
   }
 
   // o3    μg/m^3, Ozone (O3)
   // When 8-hour o3 concentration is > 785 μg/m^3, then the PSI sub-index is
   // calculated using the 1 hour concentration.
-  if (o3_8h <= 785)
+  if (AQI_LE(o3_8h, 785))
   {
-    if (o3_8h < 118.5)
-    {
-      i_lo = 0;
-      i_hi = 50;
-      c_lo = 0;
-      c_hi = 118;
-    }
-    else if (o3_8h < 157.5)
-    {
-      i_lo = 51;
-      i_hi = 100;
-      c_lo = 119;
-      c_hi = 157;
-    }
-    else if (o3_8h < 235.5)
-    {
-      i_lo = 101;
-      i_hi = 200;
-      c_lo = 158;
-      c_hi = 235;
-    }
-    else
-    {
-      // o3_8h <= 785
-      i_lo = 201;
-      i_hi = 300;
-      c_lo = 236;
-      c_hi = 785;
-    }
-    psi = max(psi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, o3_8h));
+    psi = max(psi, table_aqi(&SINGAPORE_O3_8H, o3_8h, overflow));
   }
   else
   {
-    if (o3_1h < 118.5)
-    {
-      i_lo = 0;
-      i_hi = 50;
-      c_lo = 0;
-      c_hi = 118;
-    }
-    else if (o3_1h < 157.5)
-    {
-      i_lo = 51;
-      i_hi = 100;
-      c_lo = 119;
-      c_hi = 157;
-    }
-    else if (o3_1h < 235.5)
-    {
-      i_lo = 101;
-      i_hi = 200;
-      c_lo = 158;
-      c_hi = 235;
-    }
-    else if (o3_1h < 785.5)
-    {
-      i_lo = 201;
-      i_hi = 300;
-      c_lo = 236;
-      c_hi = 785;
-    }
-    else if (o3_1h < 980.5)
-    {
-      i_lo = 301;
-      i_hi = 400;
-      c_lo = 786;
-      c_hi = 980;
-    }
-    else if (o3_1h < 1180.5)
-    {
-      i_lo = 401;
-      i_hi = 500;
-      c_lo = 981;
-      c_hi = 1180;
-    }
-    else
-    {
-      // index > 500
-      return 501;
-    }
-    psi = max(psi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, o3_1h));
+    psi = max(psi, table_aqi(&SINGAPORE_O3_1H, o3_1h, overflow));
   }
 
   // so2   μg/m^3, Sulfur Dioxide (SO2)
-  if (so2_24h < 80.5)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 80;
-  }
-  else if (so2_24h < 365.5)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 81;
-    c_hi = 365;
-  }
-  else if (so2_24h < 800.5)
-  {
-    i_lo = 101;
-    i_hi = 200;
-    c_lo = 366;
-    c_hi = 800;
-  }
-  else if (so2_24h < 1600.5)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 801;
-    c_hi = 1600;
-  }
-  else if (so2_24h < 2100.5)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 1601;
-    c_hi = 2100;
-  }
-  else if (so2_24h < 2620.5)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 2101;
-    c_hi = 2620;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  psi = max(psi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, so2_24h));
+  psi = max(psi, table_aqi(&SINGAPORE_SO2_24H, so2_24h, overflow));
 
   // pm10  μg/m^3, Coarse Particulate Matter (<10μm)
-  if (pm10_24h < 50.5)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 50;
-  }
-  else if (pm10_24h < 150.5)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 51;
-    c_hi = 150;
-  }
-  else if (pm10_24h < 350.5)
-  {
-    i_lo = 101;
-    i_hi = 200;
-    c_lo = 151;
-    c_hi = 350;
-  }
-  else if (pm10_24h < 420.5)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 351;
-    c_hi = 420;
-  }
-  else if (pm10_24h < 500.5)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 421;
-    c_hi = 500;
-  }
-  else if (pm10_24h < 600.5)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 501;
-    c_hi = 600;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  psi = max(psi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, pm10_24h));
+  psi = max(psi, table_aqi(&SINGAPORE_PM10_24H, pm10_24h, overflow));
 
   // pm2_5 μg/m^3, Fine Particulate Matter (<2.5μm)
-  if (pm2_5_24h < 12.5)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 12;
-  }
-  else if (pm2_5_24h < 55.5)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 13;
-    c_hi = 55;
-  }
-  else if (pm2_5_24h < 150.5)
-  {
-    i_lo = 101;
-    i_hi = 200;
-    c_lo = 56;
-    c_hi = 150;
-  }
-  else if (pm2_5_24h < 250.5)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 151;
-    c_hi = 250;
-  }
-  else if (pm2_5_24h < 350.5)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 251;
-    c_hi = 350;
-  }
-  else if (pm2_5_24h < 500.5)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 351;
-    c_hi = 500;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  psi = max(psi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, pm2_5_24h));
+  psi = max(psi, table_aqi(&SINGAPORE_PM2_5_24H, pm2_5_24h, overflow));
 
   return psi;
+} // end singapore_psi_conc
+
+int singapore_psi(float co_8h,   float no2_1h,   float o3_1h, float o3_8h,
+                  float so2_24h, float pm10_24h, float pm2_5_24h)
+{
+  return singapore_psi_conc(AQI_CONC(co_8h), AQI_CONC(no2_1h), AQI_CONC(o3_1h),
+                            AQI_CONC(o3_8h), AQI_CONC(so2_24h),
+                            AQI_CONC(pm10_24h), AQI_CONC(pm2_5_24h));
 } // end singapore_psi
 
+static const aqi_breakpoint_t SOUTH_KOREA_CO_1H_BP[] =
+{
+  AQI_BP( 2348.48,        0,  2291.2,   0,  50),
+  AQI_BP(10367.68,  2405.76, 10310.4,  51, 100),
+  AQI_BP(17241.28, 10424.96,   17184, 101, 250),
+  AQI_BP(57337.28, 17298.56,   57280, 251, 500),
+};
+static const aqi_table_t SOUTH_KOREA_CO_1H = AQI_TABLE(SOUTH_KOREA_CO_1H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t SOUTH_KOREA_NO2_1H_BP[] =
+{
+  AQI_BP( 57.3888,        0,  56.448,   0,  50),
+  AQI_BP(113.8368,  58.3296, 112.896,  51, 100),
+  AQI_BP(377.2608, 114.7776,  376.32, 101, 250),
+  AQI_BP(3772.608, 378.2016,  3763.2, 251, 500),
+};
+static const aqi_table_t SOUTH_KOREA_NO2_1H = AQI_TABLE(SOUTH_KOREA_NO2_1H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t SOUTH_KOREA_O3_1H_BP[] =
+{
+  AQI_BP(  59.8776,        0,  58.896,   0,  50),
+  AQI_BP( 177.6696,  60.8592, 176.688,  51, 100),
+  AQI_BP( 295.4616, 178.6512,  294.48, 101, 250),
+  AQI_BP(1178.9016, 296.4432, 1177.92, 251, 500),
+};
+static const aqi_table_t SOUTH_KOREA_O3_1H = AQI_TABLE(SOUTH_KOREA_O3_1H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t SOUTH_KOREA_SO2_1H_BP[] =
+{
+  AQI_BP( 173.7252,         0, 169.488,   0,  50),
+  AQI_BP( 427.9572,  177.9624,  423.72,  51, 100),
+  AQI_BP(  1271.16,  432.1944, 1271.16, 101, 250),
+  AQI_BP(8478.6372, 1279.6344,  8474.4, 251, 500),
+};
+static const aqi_table_t SOUTH_KOREA_SO2_1H = AQI_TABLE(SOUTH_KOREA_SO2_1H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t SOUTH_KOREA_PM10_24H_BP[] =
+{
+  AQI_BP( 30.5,   0,  30,   0,  50),
+  AQI_BP( 80.5,  31,  80,  51, 100),
+  AQI_BP(150.5,  81, 150, 101, 250),
+  AQI_BP(600.5, 151, 600, 251, 500),
+};
+static const aqi_table_t SOUTH_KOREA_PM10_24H = AQI_TABLE(SOUTH_KOREA_PM10_24H_BP, AQI_EXCLUSIVE);
+
+static const aqi_breakpoint_t SOUTH_KOREA_PM2_5_24H_BP[] =
+{
+  AQI_BP( 15.5,  0,  15,   0,  50),
+  AQI_BP( 35.5, 16,  35,  51, 100),
+  AQI_BP( 75.5, 36,  75, 101, 250),
+  AQI_BP(500.5, 76, 500, 251, 500),
+};
+static const aqi_table_t SOUTH_KOREA_PM2_5_24H = AQI_TABLE(SOUTH_KOREA_PM2_5_24H_BP, AQI_EXCLUSIVE);
+
 /* South Korea (CAI)
  *
  * References:
  *   https://www.airkorea.or.kr/eng/khaiInfo?pMENU_NO=166
  */
-int south_korea_cai(float co_1h,  float no2_1h,   float o3_1h,
-                    float so2_1h, float pm10_24h, float pm2_5_24h)
+static int south_korea_cai_conc(aqi_conc_t co_1h, aqi_conc_t no2_1h,
+                                aqi_conc_t o3_1h, aqi_conc_t so2_1h,
+                                aqi_conc_t pm10_24h, aqi_conc_t pm2_5_24h)
 {
+  const int overflow = 501; // index > 500
   int cai = 0;
-  float i_lo, i_hi;
-  float c_lo, c_hi;
 
   // co    μg/m^3, Carbon Monoxide (CO)
   // 1ppm * 1000ppb/1ppm * 1.1456 μg/m^3/ppb = 1145.6 μg/m^3
-  if (co_1h < 2348.48)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 2291.2;
-  }
-  else if (co_1h < 10367.68)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 2405.76;
-    c_hi = 10310.4;
-  }
-  else if (co_1h < 17241.28)
-  {
-    i_lo = 101;
-    i_hi = 250;
-    c_lo = 10424.96;
-    c_hi = 17184;
-  }
-  else if (co_1h < 57337.28)
-  {
-    i_lo = 251;
-    i_hi = 500;
-    c_lo = 17298.56;
-    c_hi = 57280;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  cai = max(cai, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, co_1h));
+  cai = max(cai, table_aqi(&SOUTH_KOREA_CO_1H, co_1h, overflow));
 
   // no2   μg/m^3, Nitrogen Dioxide (NO2)
   // 1ppm * 1000ppb/1ppm * 1.8816 μg/m^3/ppb = 1881.6 μg/m^3
-  if (no2_1h < 57.3888)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 56.448;
-  }
-  else if (no2_1h < 113.8368)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 58.3296;
-    c_hi = 112.896;
-  }
-  else if (no2_1h < 377.2608)
-  {
-    i_lo = 101;
-    i_hi = 250;
-    c_lo = 114.7776;
-    c_hi = 376.32;
-  }
-  else if (no2_1h < 3772.608)
-  {
-    i_lo = 251;
-    i_hi = 500;
-    c_lo = 378.2016;
-    c_hi = 3763.2;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  cai = max(cai, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, no2_1h));
+  cai = max(cai, table_aqi(&SOUTH_KOREA_NO2_1H, no2_1h, overflow));
 
   // o3    μg/m^3, Ozone (O3)
   // 1ppm * 1000ppb/1ppm * 1.9632 μg/m^3/ppb = 1963.2 μg/m^3
-  if (o3_1h < 59.8776)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 58.896;
-  }
-  else if (o3_1h < 177.6696)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 60.8592;
-    c_hi = 176.688;
-  }
-  else if (o3_1h < 295.4616)
-  {
-    i_lo = 101;
-    i_hi = 250;
-    c_lo = 178.6512;
-    c_hi = 294.48;
-  }
-  else if (o3_1h < 1178.9016)
-  {
-    i_lo = 251;
-    i_hi = 500;
-    c_lo = 296.4432;
-    c_hi = 1177.92;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  cai = max(cai, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, o3_1h));
+  cai = max(cai, table_aqi(&SOUTH_KOREA_O3_1H, o3_1h, overflow));
 
   // so2   μg/m^3, Sulfur Dioxide (SO2)
   // 1ppm * 1000ppb/1ppm * 8.4744 μg/m^3/ppb = 8474.4 μg/m^3
-  if (so2_1h < 173.7252)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 169.488;
-  }
-  else if (so2_1h < 427.9572)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 177.9624;
-    c_hi = 423.72;
-  }
-  else if (so2_1h < 1271.16)
-  {
-    i_lo = 101;
-    i_hi = 250;
-    c_lo = 432.1944;
-    c_hi = 1271.16;
-  }
-  else if (so2_1h < 8478.6372)
-  {
-    i_lo = 251;
-    i_hi = 500;
-    c_lo = 1279.6344;
-    c_hi = 8474.4;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  cai = max(cai, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, so2_1h));
+  cai = max(cai, table_aqi(&SOUTH_KOREA_SO2_1H, so2_1h, overflow));
 
   // pm10  μg/m^3, Coarse Particulate Matter (<10μm)
-  if (pm10_24h < 30.5)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 30;
-  }
-  else if (pm10_24h < 80.5)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 31;
-    c_hi = 80;
-  }
-  else if (pm10_24h < 150.5)
-  {
-    i_lo = 101;
-    i_hi = 250;
-    c_lo = 81;
-    c_hi = 150;
-  }
-  else if (pm10_24h < 600.5)
-  {
-    i_lo = 251;
-    i_hi = 500;
-    c_lo = 151;
-    c_hi = 600;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  cai = max(cai, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, pm10_24h));
+  cai = max(cai, table_aqi(&SOUTH_KOREA_PM10_24H, pm10_24h, overflow));
 
   // pm2_5 μg/m^3, Fine Particulate Matter (<2.5μm)
-  if (pm2_5_24h < 15.5)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 15;
-  }
-  else if (pm2_5_24h < 35.5)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 16;
-    c_hi = 35;
-  }
-  else if (pm2_5_24h < 75.5)
-  {
-    i_lo = 101;
-    i_hi = 250;
-    c_lo = 36;
-    c_hi = 75;
-  }
-  else if (pm2_5_24h < 500.5)
+  cai = max(cai, table_aqi(&SOUTH_KOREA_PM2_5_24H, pm2_5_24h, overflow));
+
+  return cai;
+} // end south_korea_cai_conc
+
+int south_korea_cai(float co_1h,  float no2_1h,   float o3_1h,
+                    float so2_1h, float pm10_24h, float pm2_5_24h)
+{
+  return south_korea_cai_conc(AQI_CONC(co_1h), AQI_CONC(no2_1h),
+                              AQI_CONC(o3_1h), AQI_CONC(so2_1h),
+                              AQI_CONC(pm10_24h), AQI_CONC(pm2_5_24h));
+} // end south_korea_cai
+
+/* Lower bound of DAQI bands 2 through 10 for each pollutant. Pollutant
+ * averages are rounded to nearest integer, hence the .5 bounds.
+ */
+static const aqi_bound_t UK_O3_8H_BOUNDS[] =
+{
+  AQI_C(33.5), AQI_C(66.5), AQI_C(100.5), AQI_C(120.5), AQI_C(140.5),
+  AQI_C(160.5), AQI_C(187.5), AQI_C(213.5), AQI_C(240.5),
+};
+static const aqi_bound_t UK_NO2_1H_BOUNDS[] =
+{
+  AQI_C(67.5), AQI_C(134.5), AQI_C(200.5), AQI_C(267.5), AQI_C(334.5),
+  AQI_C(400.5), AQI_C(467.5), AQI_C(534.5), AQI_C(600.5),
+};
+static const aqi_bound_t UK_SO2_15MIN_BOUNDS[] =
+{
+  AQI_C(88.5), AQI_C(177.5), AQI_C(266.5), AQI_C(354.5), AQI_C(443.5),
+  AQI_C(532.5), AQI_C(710.5), AQI_C(887.5), AQI_C(1064.5),
+};
+static const aqi_bound_t UK_PM2_5_24H_BOUNDS[] =
+{
+  AQI_C(11.5), AQI_C(23.5), AQI_C(35.5), AQI_C(41.5), AQI_C(47.5), AQI_C(53.5),
+  AQI_C(58.5), AQI_C(64.5), AQI_C(70.5),
+};
+static const aqi_bound_t UK_PM10_24H_BOUNDS[] =
+{
+  AQI_C(16.5), AQI_C(33.5), AQI_C(50.5), AQI_C(58.5), AQI_C(66.5), AQI_C(75.5),
+  AQI_C(83.5), AQI_C(91.5), AQI_C(100.5),
+};
+#define UK_DAQI_BANDS 9
+
+/* Returns the DAQI band (1-10) of concentration c given the lower bounds of
+ * bands 2 through 10.
+ */
+static int uk_daqi_band(const aqi_bound_t *bounds, aqi_conc_t c)
+{
+#ifdef AQI_FIXED_POINT
+  if (c == AQI_CONC_NAN)
   {
-    i_lo = 251;
-    i_hi = 500;
-    c_lo = 76;
-    c_hi = 500;
+    return 1; // like the float comparisons below
   }
-  else
+#endif
+  int lo = 0;
+  int hi = UK_DAQI_BANDS;
+  while (lo < hi)
   {
-    // index > 500
-    return 501;
+    int mid = (lo + hi) / 2;
+    if (c >= bounds[mid])
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
   }
-  cai = max(cai, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, pm2_5_24h));
-
-  return cai;
-} // end south_korea_cai
+  return lo + 1;
+} // end uk_daqi_band
 
 /* United Kingdom (DAQI)
  *
@@ -1897,61 +1160,115 @@ int south_korea_cai(float co_1h,  float no2_1h,   float o3_1h,
  *   https://en.wikipedia.org/wiki/Air_quality_index#United_Kingdom
  *   https://uk-air.defra.gov.uk/library/reports?report_id=750
  */
+static int united_kingdom_daqi_conc(aqi_conc_t no2_1h, aqi_conc_t o3_8h,
+                                    aqi_conc_t so2_15min, aqi_conc_t pm10_24h,
+                                    aqi_conc_t pm2_5_24h)
+{
+  int daqi = 1;
+  daqi = max(daqi, uk_daqi_band(UK_O3_8H_BOUNDS, o3_8h));
+  daqi = max(daqi, uk_daqi_band(UK_NO2_1H_BOUNDS, no2_1h));
+  daqi = max(daqi, uk_daqi_band(UK_SO2_15MIN_BOUNDS, so2_15min));
+  daqi = max(daqi, uk_daqi_band(UK_PM2_5_24H_BOUNDS, pm2_5_24h));
+  daqi = max(daqi, uk_daqi_band(UK_PM10_24H_BOUNDS, pm10_24h));
+  return daqi;
+} // end united_kingdom_daqi_conc
+
 int united_kingdom_daqi(float no2_1h,   float o3_8h, float so2_15min,
                         float pm10_24h, float pm2_5_24h)
 {
-  // Pollutant averages are rounded to nearest integer
-  if (o3_8h >= 240.5 || no2_1h >= 600.5 || so2_15min >= 1064.5 ||
-      pm2_5_24h >= 70.5 || pm10_24h >= 100.5)
-  {
-    return 10;
-  }
-  else if (o3_8h >= 213.5 || no2_1h >= 534.5 || so2_15min >= 887.5 ||
-           pm2_5_24h >= 64.5 || pm10_24h >= 91.5)
-  {
-    return 9;
-  }
-  else if (o3_8h >= 187.5 || no2_1h >= 467.5 || so2_15min >= 710.5 ||
-           pm2_5_24h >= 58.5 || pm10_24h >= 83.5)
-  {
-    return 8;
-  }
-  else if (o3_8h >= 160.5 || no2_1h >= 400.5 || so2_15min >= 532.5 ||
-           pm2_5_24h >= 53.5 || pm10_24h >= 75.5)
-  {
-    return 7;
-  }
-  else if (o3_8h >= 140.5 || no2_1h >= 334.5 || so2_15min >= 443.5 ||
-           pm2_5_24h >= 47.5 || pm10_24h >= 66.5)
-  {
-    return 6;
-  }
-  else if (o3_8h >= 120.5 || no2_1h >= 267.5 || so2_15min >= 354.5 ||
-           pm2_5_24h >= 41.5 || pm10_24h >= 58.5)
-  {
-    return 5;
-  }
-  else if (o3_8h >= 100.5 || no2_1h >= 200.5 || so2_15min >= 266.5 ||
-           pm2_5_24h >= 35.5 || pm10_24h >= 50.5)
-  {
-    return 4;
-  }
-  else if (o3_8h >= 66.5 || no2_1h >= 134.5 || so2_15min >= 177.5 ||
-           pm2_5_24h >= 23.5 || pm10_24h >= 33.5)
-  {
-    return 3;
-  }
-  else if (o3_8h >= 33.5 || no2_1h >= 67.5 || so2_15min >= 88.5 ||
-           pm2_5_24h >= 11.5 || pm10_24h >= 16.5)
-  {
-    return 2;
-  }
-  else
-  {
-    return 1;
-  }
+  return united_kingdom_daqi_conc(AQI_CONC(no2_1h), AQI_CONC(o3_8h),
+                                  AQI_CONC(so2_15min), AQI_CONC(pm10_24h),
+                                  AQI_CONC(pm2_5_24h));
 } // end united_kingdom_daqi
 
+static const aqi_breakpoint_t US_CO_8H_BP[] =
+{
+  AQI_BP(  4.4,    0,  4.4,   0,  50),
+  AQI_BP(  9.4,  4.5,  9.4,  51, 100),
+  AQI_BP( 12.4,  9.5, 12.4, 101, 150),
+  AQI_BP( 15.4, 12.5, 15.4, 151, 200),
+  AQI_BP( 30.4, 15.5, 30.4, 201, 300),
+  AQI_BP( 40.4, 30.5, 40.4, 301, 400),
+  AQI_BP( 50.4, 40.5, 50.4, 401, 500),
+};
+static const aqi_table_t US_CO_8H = AQI_TABLE(US_CO_8H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t US_NO2_1H_BP[] =
+{
+  AQI_BP(   53,    0,   53,   0,  50),
+  AQI_BP(  100,   54,  100,  51, 100),
+  AQI_BP(  360,  101,  360, 101, 150),
+  AQI_BP(  649,  361,  649, 151, 200),
+  AQI_BP( 1249,  350, 1249, 201, 300),
+  AQI_BP( 1649, 1250, 1649, 301, 400),
+  AQI_BP( 2049, 1650, 2049, 401, 500),
+};
+static const aqi_table_t US_NO2_1H = AQI_TABLE(US_NO2_1H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t US_O3_1H_BP[] =
+{
+  AQI_BP(0.164, 0.125, 0.164, 101, 150),
+  AQI_BP(0.204, 0.165, 0.204, 151, 200),
+  AQI_BP(0.404, 0.205, 0.404, 201, 300),
+  AQI_BP( 1649,  1250,  1649, 301, 400),
+  AQI_BP( 2049,  1650,  2049, 401, 500),
+};
+static const aqi_table_t US_O3_1H = AQI_TABLE(US_O3_1H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t US_O3_8H_BP[] =
+{
+  AQI_BP(   0.054,     0, 0.054,   0,  50),
+  AQI_BP(   0.070, 0.055, 0.070,  51, 100),
+  AQI_BP(   0.085, 0.071, 0.085, 101, 150),
+  AQI_BP(   0.105, 0.086, 0.105, 151, 200),
+  AQI_BP(INFINITY, 0.106, 0.200, 201, 300),
+};
+static const aqi_table_t US_O3_8H = AQI_TABLE(US_O3_8H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t US_SO2_1H_BP[] =
+{
+  AQI_BP(      35,  0,  35,   0,  50),
+  AQI_BP(      75, 36,  75,  51, 100),
+  AQI_BP(INFINITY, 76, 185, 101, 150),
+};
+static const aqi_table_t US_SO2_1H = AQI_TABLE(US_SO2_1H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t US_SO2_24H_BP[] =
+{
+  AQI_BP(   35,   0,   35,   0,  50),
+  AQI_BP(   75,  36,   75,  51, 100),
+  AQI_BP(  185,  76,  185, 101, 150),
+  AQI_BP(  304, 186,  304, 151, 200),
+  AQI_BP(  604, 305,  604, 201, 300),
+  AQI_BP(  804, 605,  804, 301, 400),
+  AQI_BP( 1004, 805, 1004, 401, 500),
+};
+static const aqi_table_t US_SO2_24H = AQI_TABLE(US_SO2_24H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t US_PM10_24H_BP[] =
+{
+  AQI_BP(   54,   0,  54,   0,  50),
+  AQI_BP(  154,  55, 154,  51, 100),
+  AQI_BP(  254, 155, 254, 101, 150),
+  AQI_BP(  354, 255, 354, 151, 200),
+  AQI_BP(  424, 355, 424, 201, 300),
+  AQI_BP(  504, 425, 504, 301, 400),
+  AQI_BP(  604, 505, 604, 401, 500),
+};
+static const aqi_table_t US_PM10_24H = AQI_TABLE(US_PM10_24H_BP, AQI_INCLUSIVE);
+
+static const aqi_breakpoint_t US_PM2_5_24H_BP[] =
+{
+  AQI_BP( 12.0,     0,  12.0,   0,  50),
+  AQI_BP( 35.4,  12.1,  35.4,  51, 100),
+  AQI_BP( 55.4,  35.5,  55.4, 101, 150),
+  AQI_BP(150.4,  55.5, 150.4, 151, 200),
+  AQI_BP(250.4, 150.5, 250.4, 201, 300),
+  AQI_BP(350.4, 250.5, 350.4, 301, 400),
+  AQI_BP(500.4, 350.5, 500.4, 401, 500),
+};
+static const aqi_table_t US_PM2_5_24H = AQI_TABLE(US_PM2_5_24H_BP, AQI_INCLUSIVE);
+
 /* United States (AQI)
  *
  * References:
@@ -1959,425 +1276,77 @@ int united_kingdom_daqi(float no2_1h,   float o3_8h, float so2_15min,
  *   https://www.airnow.gov/sites/default/files/2020-05/aqi-technical-assistance-document-sept2018.pdf
  *   https://en.wikipedia.org/wiki/Air_quality_index#United_States
  */
-int united_states_aqi(float co_8h,    float no2_1h,
-                      float o3_1h,    float o3_8h,
-                      float so2_1h,   float so2_24h,
-                      float pm10_24h, float pm2_5_24h)
+static int united_states_aqi_conc(aqi_conc_t co_8h, aqi_conc_t no2_1h,
+                                  aqi_conc_t o3_1h, aqi_conc_t o3_8h,
+                                  aqi_conc_t so2_1h, aqi_conc_t so2_24h,
+                                  aqi_conc_t pm10_24h, aqi_conc_t pm2_5_24h)
 {
+  const int overflow = 501; // index > 500
   int aqi = 0;
-  float i_lo, i_hi;
-  float c_lo, c_hi;
 
   // Pollutant averages are truncated
+#ifdef AQI_FIXED_POINT
+  co_8h = convert_truncate(co_8h, 10, 11456, 10);       // (ppm) 1 decimal place
+  no2_1h = convert_truncate_int(no2_1h, 10000, 18816);  // (ppb) integer
+  o3_1h = convert_truncate(o3_1h, 10, 19632, 1000);     // (ppm) 3 decimal places
+  o3_8h = convert_truncate(o3_8h, 10, 19632, 1000);     // (ppm) 3 decimal places
+  so2_1h = convert_truncate_int(so2_1h, 10000, 84744);  // (ppb) integer
+  pm10_24h = convert_truncate_int(pm10_24h, 1, 1);      // (μg/m^3) integer
+  pm2_5_24h = convert_truncate(pm2_5_24h, 1, 1, 10);    // (μg/m^3) 1 decimal place
+#else
   co_8h = truncate_float(co_8h / 1145.6, 1); // (ppm) truncate to 1 decimal place
-  no2_1h = (int)(no2_1h / 1.8816);           // (ppb) truncate to integer
+  no2_1h = truncate_int(no2_1h / 1.8816);    // (ppb) truncate to integer
   o3_1h = truncate_float(o3_1h / 1963.2, 3); // (ppm) truncate to 3 decimal places
   o3_8h = truncate_float(o3_8h / 1963.2, 3); // (ppm) truncate to 3 decimal places
-  so2_1h = (int)(so2_1h / 8.4744);           // (ppb) truncate to integer
-  pm10_24h = (int)pm10_24h;                  // (μg/m^3) truncate to integer
+  so2_1h = truncate_int(so2_1h / 8.4744);    // (ppb) truncate to integer
+  pm10_24h = truncate_int(pm10_24h);         // (μg/m^3) truncate to integer
   pm2_5_24h = truncate_float(pm2_5_24h, 1);  // (μg/m^3) truncate to 1 decimal place
+#endif
 
   // co    μg/m^3, Carbon Monoxide (CO)
-  if (co_8h <= 4.4)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 4.4;
-  }
-  else if (co_8h <= 9.4)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 4.5;
-    c_hi = 9.4;
-  }
-  else if (co_8h <= 12.4)
-  {
-    i_lo = 101;
-    i_hi = 150;
-    c_lo = 9.5;
-    c_hi = 12.4;
-  }
-  else if (co_8h <= 15.4)
-  {
-    i_lo = 151;
-    i_hi = 200;
-    c_lo = 12.5;
-    c_hi = 15.4;
-  }
-  else if (co_8h <= 30.4)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 15.5;
-    c_hi = 30.4;
-  }
-  else if (co_8h <= 40.4)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 30.5;
-    c_hi = 40.4;
-  }
-  else if (co_8h <= 50.4)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 40.5;
-    c_hi = 50.4;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, co_8h));
+  aqi = max(aqi, table_aqi(&US_CO_8H, co_8h, overflow));
 
   // no2   μg/m^3, Nitrogen Dioxide (NO2)
-  if (no2_1h <= 53)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 53;
-  }
-  else if (no2_1h <= 100)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 54;
-    c_hi = 100;
-  }
-  else if (no2_1h <= 360)
-  {
-    i_lo = 101;
-    i_hi = 150;
-    c_lo = 101;
-    c_hi = 360;
-  }
-  else if (no2_1h <= 649)
-  {
-    i_lo = 151;
-    i_hi = 200;
-    c_lo = 361;
-    c_hi = 649;
-  }
-  else if (no2_1h <= 1249)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 350;
-    c_hi = 1249;
-  }
-  else if (no2_1h <= 1649)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 1250;
-    c_hi = 1649;
-  }
-  else if (no2_1h <= 2049)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 1650;
-    c_hi = 2049;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, no2_1h));
+  aqi = max(aqi, table_aqi(&US_NO2_1H, no2_1h, overflow));
 
   // o3    μg/m^3, Ground-Level Ozone (O3)
-  if (o3_1h >= 0.125)
+  if (AQI_GE(o3_1h, 0.125))
   {
-    if (o3_1h <= 0.164)
-    {
-      i_lo = 101;
-      i_hi = 150;
-      c_lo = 0.125;
-      c_hi = 0.164;
-    }
-    else if (o3_1h <= 0.204)
-    {
-      i_lo = 151;
-      i_hi = 200;
-      c_lo = 0.165;
-      c_hi = 0.204;
-    }
-    else if (o3_1h <= 0.404)
-    {
-      i_lo = 201;
-      i_hi = 300;
-      c_lo = 0.205;
-      c_hi = 0.404;
-    }
-    else if (o3_1h <= 1649)
-    {
-      i_lo = 301;
-      i_hi = 400;
-      c_lo = 1250;
-      c_hi = 1649;
-    }
-    else if (o3_1h <= 2049)
-    {
-      i_lo = 401;
-      i_hi = 500;
-      c_lo = 1650;
-      c_hi = 2049;
-    }
-    else
-    {
-      // index > 500
-      return 501;
-    }
-    aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, o3_1h));
+    aqi = max(aqi, table_aqi(&US_O3_1H, o3_1h, overflow));
   }
-  if (o3_8h <= 0.200)
+  if (AQI_LE(o3_8h, 0.200))
   {
-    if (o3_8h <= 0.054)
-    {
-      i_lo = 0;
-      i_hi = 50;
-      c_lo = 0;
-      c_hi = 0.054;
-    }
-    else if (o3_8h <= 0.070)
-    {
-      i_lo = 51;
-      i_hi = 100;
-      c_lo = 0.055;
-      c_hi = 0.070;
-    }
-    else if (o3_8h <= 0.085)
-    {
-      i_lo = 101;
-      i_hi = 150;
-      c_lo = 0.071;
-      c_hi = 0.085;
-    }
-    else if (o3_8h <= 0.105)
-    {
-      i_lo = 151;
-      i_hi = 200;
-      c_lo = 0.086;
-      c_hi = 0.105;
-    }
-    else
-    {
-      // 0.106 <= o3_8h <= 0.200
-      i_lo = 201;
-      i_hi = 300;
-      c_lo = 0.106;
-      c_hi = 0.200;
-    }
-    aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, o3_8h));
+    aqi = max(aqi, table_aqi(&US_O3_8H, o3_8h, overflow));
   }
 
   // so2   μg/m^3, Sulfur Dioxide (SO2)
-  if (so2_1h <= 185)
+  if (AQI_LE(so2_1h, 185))
   {
-    if (so2_1h <= 35)
-    {
-      i_lo = 0;
-      i_hi = 50;
-      c_lo = 0;
-      c_hi = 35;
-    }
-    else if (so2_1h <= 75)
-    {
-      i_lo = 51;
-      i_hi = 100;
-      c_lo = 36;
-      c_hi = 75;
-    }
-    else
-    {
-      // 76 <= so2_1h <= 185
-      i_lo = 101;
-      i_hi = 150;
-      c_lo = 76;
-      c_hi = 185;
-    }
-    aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, so2_1h));
+    aqi = max(aqi, table_aqi(&US_SO2_1H, so2_1h, overflow));
   }
   else
   {
-    if (so2_24h <= 35)
-    {
-      i_lo = 0;
-      i_hi = 50;
-      c_lo = 0;
-      c_hi = 35;
-    }
-    else if (so2_24h <= 75)
-    {
-      i_lo = 51;
-      i_hi = 100;
-      c_lo = 36;
-      c_hi = 75;
-    }
-    else if (so2_24h <= 185)
-    {
-      i_lo = 101;
-      i_hi = 150;
-      c_lo = 76;
-      c_hi = 185;
-    }
-    else if (so2_24h <= 304)
-    {
-      i_lo = 151;
-      i_hi = 200;
-      c_lo = 186;
-      c_hi = 304;
-    }
-    else if (so2_24h <= 604)
-    {
-      i_lo = 201;
-      i_hi = 300;
-      c_lo = 305;
-      c_hi = 604;
-    }
-    else if (so2_24h <= 804)
-    {
-      i_lo = 301;
-      i_hi = 400;
-      c_lo = 605;
-      c_hi = 804;
-    }
-    else if (so2_24h <= 1004)
-    {
-      i_lo = 401;
-      i_hi = 500;
-      c_lo = 805;
-      c_hi = 1004;
-    }
-    else
-    {
-      // index > 500
-      return 501;
-    }
-    aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, so2_24h));
+    aqi = max(aqi, table_aqi(&US_SO2_24H, so2_24h, overflow));
   }
 
   // pm10  μg/m^3, Coarse Particulate Matter (<10μm)
-  if (pm10_24h <= 54)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 54;
-  }
-  else if (pm10_24h <= 154)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 55;
-    c_hi = 154;
-  }
-  else if (pm10_24h <= 254)
-  {
-    i_lo = 101;
-    i_hi = 150;
-    c_lo = 155;
-    c_hi = 254;
-  }
-  else if (pm10_24h <= 354)
-  {
-    i_lo = 151;
-    i_hi = 200;
-    c_lo = 255;
-    c_hi = 354;
-  }
-  else if (pm10_24h <= 424)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 355;
-    c_hi = 424;
-  }
-  else if (pm10_24h <= 504)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 425;
-    c_hi = 504;
-  }
-  else if (pm10_24h <= 604)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 505;
-    c_hi = 604;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, pm10_24h));
+  aqi = max(aqi, table_aqi(&US_PM10_24H, pm10_24h, overflow));
 
   // pm2_5 μg/m^3, Fine Particulate Matter (<2.5μm)
-  if (pm2_5_24h <= 12.0)
-  {
-    i_lo = 0;
-    i_hi = 50;
-    c_lo = 0;
-    c_hi = 12.0;
-  }
-  else if (pm2_5_24h <= 35.4)
-  {
-    i_lo = 51;
-    i_hi = 100;
-    c_lo = 12.1;
-    c_hi = 35.4;
-  }
-  else if (pm2_5_24h <= 55.4)
-  {
-    i_lo = 101;
-    i_hi = 150;
-    c_lo = 35.5;
-    c_hi = 55.4;
-  }
-  else if (pm2_5_24h <= 150.4)
-  {
-    i_lo = 151;
-    i_hi = 200;
-    c_lo = 55.5;
-    c_hi = 150.4;
-  }
-  else if (pm2_5_24h <= 250.4)
-  {
-    i_lo = 201;
-    i_hi = 300;
-    c_lo = 150.5;
-    c_hi = 250.4;
-  }
-  else if (pm2_5_24h <= 350.4)
-  {
-    i_lo = 301;
-    i_hi = 400;
-    c_lo = 250.5;
-    c_hi = 350.4;
-  }
-  else if (pm2_5_24h <= 500.4)
-  {
-    i_lo = 401;
-    i_hi = 500;
-    c_lo = 350.5;
-    c_hi = 500.4;
-  }
-  else
-  {
-    // index > 500
-    return 501;
-  }
-  aqi = max(aqi, compute_piecewise_aqi(i_lo, i_hi, c_lo, c_hi, pm2_5_24h));
+  aqi = max(aqi, table_aqi(&US_PM2_5_24H, pm2_5_24h, overflow));
 
   return aqi;
+} // end united_states_aqi_conc
+
+int united_states_aqi(float co_8h,    float no2_1h,
+                      float o3_1h,    float o3_8h,
+                      float so2_1h,   float so2_24h,
+                      float pm10_24h, float pm2_5_24h)
+{
+  return united_states_aqi_conc(AQI_CONC(co_8h), AQI_CONC(no2_1h),
+                                AQI_CONC(o3_1h), AQI_CONC(o3_8h),
+                                AQI_CONC(so2_1h), AQI_CONC(so2_24h),
+                                AQI_CONC(pm10_24h), AQI_CONC(pm2_5_24h));
 } // end united_states_aqi
 
 /*
@@ -2654,47 +1623,277 @@ const char *united_states_aqi_desc(int aqi)
   }
 } // end united_states_aqi_desc
 
-/* Returns the average pollutant concentration over a given number of previous
- * hours.
- *
- * 'pollutant' is an array of hourly concentrations. The last element in
- * pollutant is the most recent hourly concentration. 'hours' must be a positive
- * integer.
+/* Sets entry i of the running sums of pollutant p to entry prev plus conc.
+ */
+static void sums_add(aqi_conc_sums_t *sums, int p, int i, int prev, float conc)
+{
+  int finite = isfinite(conc);
+  aqi_nonfinite_t *n = &sums->nonfinite[p][i];
+  sums->sum[p][i] = sums->sum[p][prev] + (finite ? AQI_CONC(conc) : 0);
+  *n = sums->nonfinite[p][prev];
+  n->nan += isnan(conc) != 0;
+  n->inf += isinf(conc) && conc > 0;
+  n->neg_inf += isinf(conc) && conc < 0;
+} // end sums_add
+
+/* Returns the sum of the samples of pollutant p after entry start up to the
+ * head if they include a NaN or infinite sample (NaN, INFINITY or -INFINITY),
+ * otherwise 0.
+ */
+static float sums_nonfinite(const aqi_conc_sums_t *sums, int p, int start)
+{
+  const aqi_nonfinite_t *a = &sums->nonfinite[p][start];
+  const aqi_nonfinite_t *b = &sums->nonfinite[p][sums->head];
+  int inf = (uint8_t)(b->inf - a->inf) != 0;
+  int neg_inf = (uint8_t)(b->neg_inf - a->neg_inf) != 0;
+  if ((uint8_t)(b->nan - a->nan) != 0 || (inf && neg_inf))
+  {
+    return NAN;
+  }
+  return inf ? INFINITY : neg_inf ? -INFINITY : 0.f;
+} // end sums_nonfinite
+
+/* Fills 'sums' with the running sums of the hourly pollutant concentration
+ * samples. Arrays are organized from least recent (index 0) to most recent
+ * (index 23).
  *
- * Passing NULL will return 0.
+ * Passing NULL for a pollutant is equivalent to passing an array of 0's.
+ */
+void aqi_conc_sums_init(aqi_conc_sums_t *sums,
+             const float co[24],  const float nh3[24],  const float no[24],
+             const float no2[24], const float o3[24],   const float pb[24],
+             const float so2[24], const float pm10[24], const float pm2_5[24])
+{
+  const float *samples[NUM_AQI_POLLUTANTS] =
+  {
+    co, nh3, no, no2, o3, pb, so2, pm10, pm2_5,
+  };
+
+  for (int p = 0; p < NUM_AQI_POLLUTANTS; ++p)
+  {
+    sums->sum[p][0] = 0;
+    sums->nonfinite[p][0] = (aqi_nonfinite_t){0, 0, 0};
+    for (int h = 0; h < 24; ++h)
+    {
+      sums_add(sums, p, h + 1, h, samples[p] == NULL ? 0.f : samples[p][h]);
+    }
+  }
+  sums->head = 24;
+} // end aqi_conc_sums_init
+
+/* Replaces the most recent hourly sample of a pollutant.
  */
-float avg_conc(const float pollutant[24], int hours)
+void aqi_conc_sums_update_latest(aqi_conc_sums_t *sums,
+                                 aqi_pollutant_t pollutant, float conc)
 {
-  if (pollutant == NULL)
+  int prev = (sums->head + AQI_SUMS_LEN - 1) % AQI_SUMS_LEN;
+  sums_add(sums, pollutant, sums->head, prev, conc);
+} // end aqi_conc_sums_update_latest
+
+/* Appends a new most recent hour of samples, the oldest hour is dropped.
+ * 'conc' is indexed by aqi_pollutant_t.
+ */
+void aqi_conc_sums_push_hour(aqi_conc_sums_t *sums,
+                             const float conc[NUM_AQI_POLLUTANTS])
+{
+  int prev = sums->head;
+  sums->head = (sums->head + 1) % AQI_SUMS_LEN;
+  for (int p = 0; p < NUM_AQI_POLLUTANTS; ++p)
   {
-    return 0.f;
+    sums_add(sums, p, sums->head, prev, conc[p]);
   }
+} // end aqi_conc_sums_push_hour
+
+/* Returns the average pollutant concentration over a given number of previous
+ * hours, in the representation used for evaluation. 'hours' must be an integer
+ * from 1 to 24.
+ */
+static aqi_conc_t conc_avg(const aqi_conc_sums_t *sums,
+                           aqi_pollutant_t pollutant, int hours)
+{
+  const aqi_sum_t *sum = sums->sum[pollutant];
+  int start = (sums->head + AQI_SUMS_LEN - hours) % AQI_SUMS_LEN;
+  aqi_sum_t total = sum[sums->head] - sum[start];
+  float nonfinite = sums_nonfinite(sums, pollutant, start);
+  if (nonfinite != 0)
+  {
+    return AQI_CONC(nonfinite);
+  }
+#ifdef AQI_FIXED_POINT
+  // round half away from zero
+  return (aqi_conc_t)((total >= 0 ? total + hours / 2
+                                  : total - hours / 2) / hours);
+#else
+  return (float) (total / hours);
+#endif
+} // end conc_avg
 
-  float avg = 0;
-  // index (size - 1) is most recent hourly concentration
-  for (int h = (24 - 1) - (hours - 1) ; h < 24 ; ++h)
+/* Returns the average pollutant concentration over a given number of previous
+ * hours. 'hours' must be an integer from 1 to 24.
+ */
+float aqi_conc_avg(const aqi_conc_sums_t *sums, aqi_pollutant_t pollutant,
+                   int hours)
+{
+#ifdef AQI_FIXED_POINT
+  const aqi_sum_t *sum = sums->sum[pollutant];
+  int start = (sums->head + AQI_SUMS_LEN - hours) % AQI_SUMS_LEN;
+  float nonfinite = sums_nonfinite(sums, pollutant, start);
+  if (nonfinite != 0)
   {
-    avg += pollutant[h];
+    return nonfinite;
   }
+  return (float) (sum[sums->head] - sum[start])
+         / ((float) hours * AQI_FIXED_SCALE);
+#else
+  return conc_avg(sums, pollutant, hours);
+#endif
+} // end aqi_conc_avg
 
-  avg = avg / (float) hours;
-  return avg;
-}
+static int sums_australia_aqi(const aqi_conc_sums_t *s)
+{
+  aqi_conc_t co_8h     = conc_avg(s, AQI_CO,     8);
+  aqi_conc_t no2_1h    = conc_avg(s, AQI_NO2,    1);
+  aqi_conc_t o3_1h     = conc_avg(s, AQI_O3,     1);
+  aqi_conc_t o3_4h     = conc_avg(s, AQI_O3,     4);
+  aqi_conc_t so2_1h    = conc_avg(s, AQI_SO2,    1);
+  aqi_conc_t pm10_24h  = conc_avg(s, AQI_PM10,  24);
+  aqi_conc_t pm2_5_24h = conc_avg(s, AQI_PM2_5, 24);
+  return australia_aqi_conc(co_8h, no2_1h, o3_1h, o3_4h, so2_1h, pm10_24h,
+                            pm2_5_24h);
+} // end sums_australia_aqi
+
+static int sums_canada_aqhi(const aqi_conc_sums_t *s)
+{
+  float no2_3h    = aqi_conc_avg(s, AQI_NO2,    3);
+  float o3_3h     = aqi_conc_avg(s, AQI_O3,     3);
+  float pm2_5_3h  = aqi_conc_avg(s, AQI_PM2_5,  3);
+  return canada_aqhi(no2_3h, o3_3h, pm2_5_3h);
+} // end sums_canada_aqhi
+
+static int sums_china_aqi(const aqi_conc_sums_t *s)
+{
+  aqi_conc_t co_1h     = conc_avg(s, AQI_CO,     1);
+  aqi_conc_t co_24h    = conc_avg(s, AQI_CO,    24);
+  aqi_conc_t no2_1h    = conc_avg(s, AQI_NO2,    1);
+  aqi_conc_t no2_24h   = conc_avg(s, AQI_NO2,   24);
+  aqi_conc_t o3_1h     = conc_avg(s, AQI_O3,     1);
+  aqi_conc_t o3_8h     = conc_avg(s, AQI_O3,     8);
+  aqi_conc_t so2_1h    = conc_avg(s, AQI_SO2,    1);
+  aqi_conc_t so2_24h   = conc_avg(s, AQI_SO2,   24);
+  aqi_conc_t pm10_24h  = conc_avg(s, AQI_PM10,  24);
+  aqi_conc_t pm2_5_24h = conc_avg(s, AQI_PM2_5, 24);
+  return china_aqi_conc(co_1h, co_24h, no2_1h, no2_24h, o3_1h, o3_8h, so2_1h,
+                        so2_24h, pm10_24h, pm2_5_24h);
+} // end sums_china_aqi
+
+static int sums_european_union_caqi(const aqi_conc_sums_t *s)
+{
+  aqi_conc_t no2_1h    = conc_avg(s, AQI_NO2,    1);
+  aqi_conc_t o3_1h     = conc_avg(s, AQI_O3,     1);
+  aqi_conc_t pm10_1h   = conc_avg(s, AQI_PM10,   1);
+  aqi_conc_t pm2_5_1h  = conc_avg(s, AQI_PM2_5,  1);
+  return european_union_caqi_conc(no2_1h, o3_1h, pm10_1h, pm2_5_1h);
+} // end sums_european_union_caqi
+
+static int sums_hong_kong_aqhi(const aqi_conc_sums_t *s)
+{
+  float no2_3h    = aqi_conc_avg(s, AQI_NO2,    3);
+  float o3_3h     = aqi_conc_avg(s, AQI_O3,     3);
+  float so2_3h    = aqi_conc_avg(s, AQI_SO2,    3);
+  float pm10_3h   = aqi_conc_avg(s, AQI_PM10,   3);
+  float pm2_5_3h  = aqi_conc_avg(s, AQI_PM2_5,  3);
+  return hong_kong_aqhi(no2_3h,  o3_3h, so2_3h, pm10_3h, pm2_5_3h);
+} // end sums_hong_kong_aqhi
+
+static int sums_india_aqi(const aqi_conc_sums_t *s)
+{
+  aqi_conc_t co_8h     = conc_avg(s, AQI_CO,     8);
+  aqi_conc_t nh3_24h   = conc_avg(s, AQI_NH3,   24);
+  aqi_conc_t no2_24h   = conc_avg(s, AQI_NO2,   24);
+  aqi_conc_t o3_8h     = conc_avg(s, AQI_O3,     8);
+  aqi_conc_t pb_24h    = conc_avg(s, AQI_PB,    24);
+  aqi_conc_t so2_24h   = conc_avg(s, AQI_SO2,   24);
+  aqi_conc_t pm10_24h  = conc_avg(s, AQI_PM10,  24);
+  aqi_conc_t pm2_5_24h = conc_avg(s, AQI_PM2_5, 24);
+  return india_aqi_conc(co_8h, nh3_24h, no2_24h, o3_8h, pb_24h, so2_24h,
+                        pm10_24h, pm2_5_24h);
+} // end sums_india_aqi
+
+static int sums_singapore_psi(const aqi_conc_sums_t *s)
+{
+  aqi_conc_t co_8h     = conc_avg(s, AQI_CO,     8);
+  aqi_conc_t no2_1h    = conc_avg(s, AQI_NO2,    1);
+  aqi_conc_t o3_1h     = conc_avg(s, AQI_O3,     1);
+  aqi_conc_t o3_8h     = conc_avg(s, AQI_O3,     8);
+  aqi_conc_t so2_24h   = conc_avg(s, AQI_SO2,   24);
+  aqi_conc_t pm10_24h  = conc_avg(s, AQI_PM10,  24);
+  aqi_conc_t pm2_5_24h = conc_avg(s, AQI_PM2_5, 24);
+  return singapore_psi_conc(co_8h, no2_1h, o3_1h, o3_8h, so2_24h, pm10_24h,
+                            pm2_5_24h);
+} // end sums_singapore_psi
+
+static int sums_south_korea_cai(const aqi_conc_sums_t *s)
+{
+  aqi_conc_t co_1h     = conc_avg(s, AQI_CO,     1);
+  aqi_conc_t no2_1h    = conc_avg(s, AQI_NO2,    1);
+  aqi_conc_t o3_1h     = conc_avg(s, AQI_O3,     1);
+  aqi_conc_t so2_1h    = conc_avg(s, AQI_SO2,    1);
+  aqi_conc_t pm10_24h  = conc_avg(s, AQI_PM10,  24);
+  aqi_conc_t pm2_5_24h = conc_avg(s, AQI_PM2_5, 24);
+  return south_korea_cai_conc(co_1h, no2_1h, o3_1h, so2_1h, pm10_24h,
+                              pm2_5_24h);
+} // end sums_south_korea_cai
+
+static int sums_united_kingdom_daqi(const aqi_conc_sums_t *s)
+{
+  aqi_conc_t no2_1h    = conc_avg(s, AQI_NO2,    1);
+  aqi_conc_t o3_8h     = conc_avg(s, AQI_O3,     8);
+  aqi_conc_t so2_15min = conc_avg(s, AQI_SO2,    1); // USING LAST HOURLY CONCENTRATION!!!
+  aqi_conc_t pm10_24h  = conc_avg(s, AQI_PM10,  24);
+  aqi_conc_t pm2_5_24h = conc_avg(s, AQI_PM2_5, 24);
+  return united_kingdom_daqi_conc(no2_1h, o3_8h, so2_15min, pm10_24h,
+                                  pm2_5_24h);
+} // end sums_united_kingdom_daqi
+
+static int sums_united_states_aqi(const aqi_conc_sums_t *s)
+{
+  aqi_conc_t co_8h     = conc_avg(s, AQI_CO,     8);
+  aqi_conc_t no2_1h    = conc_avg(s, AQI_NO2,    1);
+  aqi_conc_t o3_1h     = conc_avg(s, AQI_O3,     1);
+  aqi_conc_t o3_8h     = conc_avg(s, AQI_O3,     8);
+  aqi_conc_t so2_1h    = conc_avg(s, AQI_SO2,    1);
+  aqi_conc_t so2_24h   = conc_avg(s, AQI_SO2,   24);
+  aqi_conc_t pm10_24h  = conc_avg(s, AQI_PM10,  24);
+  aqi_conc_t pm2_5_24h = conc_avg(s, AQI_PM2_5, 24);
+  return united_states_aqi_conc(co_8h, no2_1h, o3_1h, o3_8h, so2_1h, so2_24h,
+                                pm10_24h, pm2_5_24h);
+} // end sums_united_states_aqi
+
+/* Fast lookup for evaluating an AQI scale from concentration sums. Organized
+ * alphabetically (same order as aqi_scale_t enums).
+ */
+static int (*const SUMS_AQI_LOOKUP_TABLE[NUM_AQI_SCALES])(
+                                              const aqi_conc_sums_t *) = {
+  sums_australia_aqi,
+  sums_canada_aqhi,
+  sums_china_aqi,
+  sums_european_union_caqi,
+  sums_hong_kong_aqhi,
+  sums_india_aqi,
+  sums_singapore_psi,
+  sums_south_korea_cai,
+  sums_united_kingdom_daqi,
+  sums_united_states_aqi,
+};
 
 int calc_australia_aqi(
              const float co[24],  const float nh3[24],  const float no[24],
              const float no2[24], const float o3[24],   const float pb[24],
              const float so2[24], const float pm10[24], const float pm2_5[24])
 {
-  float co_8h     = avg_conc(co,     8);
-  float no2_1h    = avg_conc(no2,    1);
-  float o3_1h     = avg_conc(o3,     1);
-  float o3_4h     = avg_conc(o3,     4);
-  float so2_1h    = avg_conc(so2,    1);
-  float pm10_24h  = avg_conc(pm10,  24);
-  float pm2_5_24h = avg_conc(pm2_5, 24);
-  return australia_aqi(co_8h, no2_1h, o3_1h, o3_4h, so2_1h, pm10_24h,
-                       pm2_5_24h);
+  aqi_conc_sums_t sums;
+  aqi_conc_sums_init(&sums, co, nh3, no, no2, o3, pb, so2, pm10, pm2_5);
+  return sums_australia_aqi(&sums);
 } // end calc_australia_aqi
 
 int calc_canada_aqhi(
@@ -2702,10 +1901,9 @@ int calc_canada_aqhi(
              const float no2[24], const float o3[24],   const float pb[24],
              const float so2[24], const float pm10[24], const float pm2_5[24])
 {
-  float no2_3h    = avg_conc(no2,    3);
-  float o3_3h     = avg_conc(o3,     3);
-  float pm2_5_3h  = avg_conc(pm2_5,  3);
-  return canada_aqhi(no2_3h, o3_3h, pm2_5_3h);
+  aqi_conc_sums_t sums;
+  aqi_conc_sums_init(&sums, co, nh3, no, no2, o3, pb, so2, pm10, pm2_5);
+  return sums_canada_aqhi(&sums);
 } // end calc_canada_aqhi
 
 int calc_china_aqi(
@@ -2713,18 +1911,9 @@ int calc_china_aqi(
              const float no2[24], const float o3[24],   const float pb[24],
              const float so2[24], const float pm10[24], const float pm2_5[24])
 {
-  float co_1h     = avg_conc(co,     1);
-  float co_24h    = avg_conc(co,    24);
-  float no2_1h    = avg_conc(no2,    1);
-  float no2_24h   = avg_conc(no2,   24);
-  float o3_1h     = avg_conc(o3,     1);
-  float o3_8h     = avg_conc(o3,     8);
-  float so2_1h    = avg_conc(so2,    1);
-  float so2_24h   = avg_conc(so2,   24);
-  float pm10_24h  = avg_conc(pm10,  24);
-  float pm2_5_24h = avg_conc(pm2_5, 24);
-  return china_aqi(co_1h, co_24h, no2_1h, no2_24h, o3_1h, o3_8h, so2_1h,
-                   so2_24h, pm10_24h, pm2_5_24h);
+  aqi_conc_sums_t sums;
+  aqi_conc_sums_init(&sums, co, nh3, no, no2, o3, pb, so2, pm10, pm2_5);
+  return sums_china_aqi(&sums);
 } // end calc_china_aqi
 
 int calc_european_union_caqi(
@@ -2732,11 +1921,9 @@ int calc_european_union_caqi(
              const float no2[24], const float o3[24],   const float pb[24],
              const float so2[24], const float pm10[24], const float pm2_5[24])
 {
-  float no2_1h    = avg_conc(no2,    1);
-  float o3_1h     = avg_conc(o3,     1);
-  float pm10_1h   = avg_conc(pm10,   1);
-  float pm2_5_1h  = avg_conc(pm2_5,  1);
-  return european_union_caqi(no2_1h, o3_1h, pm10_1h, pm2_5_1h);
+  aqi_conc_sums_t sums;
+  aqi_conc_sums_init(&sums, co, nh3, no, no2, o3, pb, so2, pm10, pm2_5);
+  return sums_european_union_caqi(&sums);
 } // end calc_european_union_caqi
 
 int calc_hong_kong_aqhi(
@@ -2744,12 +1931,9 @@ int calc_hong_kong_aqhi(
              const float no2[24], const float o3[24],   const float pb[24],
              const float so2[24], const float pm10[24], const float pm2_5[24])
 {
-  float no2_3h    = avg_conc(no2,    3);
-  float o3_3h     = avg_conc(o3,     3);
-  float so2_3h    = avg_conc(so2,    3);
-  float pm10_3h   = avg_conc(pm10,   3);
-  float pm2_5_3h  = avg_conc(pm2_5,  3);
-  return hong_kong_aqhi(no2_3h,  o3_3h, so2_3h, pm10_3h, pm2_5_3h);
+  aqi_conc_sums_t sums;
+  aqi_conc_sums_init(&sums, co, nh3, no, no2, o3, pb, so2, pm10, pm2_5);
+  return sums_hong_kong_aqhi(&sums);
 } // end calc_hong_kong_aqhi
 
 int calc_india_aqi(
@@ -2757,16 +1941,9 @@ int calc_india_aqi(
              const float no2[24], const float o3[24],   const float pb[24],
              const float so2[24], const float pm10[24], const float pm2_5[24])
 {
-  float co_8h     = avg_conc(co,     8);
-  float nh3_24h   = avg_conc(nh3,   24);
-  float no2_24h   = avg_conc(no2,   24);
-  float o3_8h     = avg_conc(o3,     8);
-  float pb_24h    = avg_conc(pb,    24);
-  float so2_24h   = avg_conc(so2,   24);
-  float pm10_24h  = avg_conc(pm10,  24);
-  float pm2_5_24h = avg_conc(pm2_5, 24);
-  return india_aqi(co_8h, nh3_24h, no2_24h, o3_8h, pb_24h, so2_24h, pm10_24h,
-                   pm2_5_24h);
+  aqi_conc_sums_t sums;
+  aqi_conc_sums_init(&sums, co, nh3, no, no2, o3, pb, so2, pm10, pm2_5);
+  return sums_india_aqi(&sums);
 } // end calc_india_aqi
 
 int calc_singapore_psi(
@@ -2774,15 +1951,9 @@ int calc_singapore_psi(
              const float no2[24], const float o3[24],   const float pb[24],
              const float so2[24], const float pm10[24], const float pm2_5[24])
 {
-  float co_8h     = avg_conc(co,     8);
-  float no2_1h    = avg_conc(no2,    1);
-  float o3_1h     = avg_conc(o3,     1);
-  float o3_8h     = avg_conc(o3,     8);
-  float so2_24h   = avg_conc(so2,   24);
-  float pm10_24h  = avg_conc(pm10,  24);
-  float pm2_5_24h = avg_conc(pm2_5, 24);
-  return singapore_psi(co_8h, no2_1h, o3_1h, o3_8h, so2_24h, pm10_24h,
-                       pm2_5_24h);
+  aqi_conc_sums_t sums;
+  aqi_conc_sums_init(&sums, co, nh3, no, no2, o3, pb, so2, pm10, pm2_5);
+  return sums_singapore_psi(&sums);
 } // end calc_singapore_psi
 
 int calc_south_korea_cai(
@@ -2790,13 +1961,9 @@ int calc_south_korea_cai(
              const float no2[24], const float o3[24],   const float pb[24],
              const float so2[24], const float pm10[24], const float pm2_5[24])
 {
-  float co_1h     = avg_conc(co,     1);
-  float no2_1h    = avg_conc(no2,    1);
-  float o3_1h     = avg_conc(o3,     1);
-  float so2_1h    = avg_conc(so2,    1);
-  float pm10_24h  = avg_conc(pm10,  24);
-  float pm2_5_24h = avg_conc(pm2_5, 24);
-  return south_korea_cai(co_1h, no2_1h, o3_1h, so2_1h, pm10_24h, pm2_5_24h);
+  aqi_conc_sums_t sums;
+  aqi_conc_sums_init(&sums, co, nh3, no, no2, o3, pb, so2, pm10, pm2_5);
+  return sums_south_korea_cai(&sums);
 } // end calc_south_korea_cai
 
 int calc_united_kingdom_daqi(
@@ -2804,12 +1971,9 @@ int calc_united_kingdom_daqi(
              const float no2[24], const float o3[24],   const float pb[24],
              const float so2[24], const float pm10[24], const float pm2_5[24])
 {
-  float no2_1h    = avg_conc(no2,    1);
-  float o3_8h     = avg_conc(o3,     8);
-  float so2_15min = avg_conc(so2,    1); // USING LAST HOURLY CONCENTRATION!!!
-  float pm10_24h  = avg_conc(pm10,  24);
-  float pm2_5_24h = avg_conc(pm2_5, 24);
-  return united_kingdom_daqi(no2_1h, o3_8h, so2_15min, pm10_24h, pm2_5_24h);
+  aqi_conc_sums_t sums;
+  aqi_conc_sums_init(&sums, co, nh3, no, no2, o3, pb, so2, pm10, pm2_5);
+  return sums_united_kingdom_daqi(&sums);
 } // end calc_united_kingdom_daqi
 
 int calc_united_states_aqi(
@@ -2817,46 +1981,39 @@ int calc_united_states_aqi(
              const float no2[24], const float o3[24],   const float pb[24],
              const float so2[24], const float pm10[24], const float pm2_5[24])
 {
-  float co_8h     = avg_conc(co,     8);
-  float no2_1h    = avg_conc(no2,    1);
-  float o3_1h     = avg_conc(o3,     1);
-  float o3_8h     = avg_conc(o3,     8);
-  float so2_1h    = avg_conc(so2,    1);
-  float so2_24h   = avg_conc(so2,   24);
-  float pm10_24h  = avg_conc(pm10,  24);
-  float pm2_5_24h = avg_conc(pm2_5, 24);
-  return united_states_aqi(co_8h, no2_1h, o3_1h, o3_8h, so2_1h, so2_24h,
-                           pm10_24h, pm2_5_24h);
+  aqi_conc_sums_t sums;
+  aqi_conc_sums_init(&sums, co, nh3, no, no2, o3, pb, so2, pm10, pm2_5);
+  return sums_united_states_aqi(&sums);
 } // end calc_united_states_aqi
 
-/* Fast lookup for calc_aqi functions. Organized alphabetically
- * (same order as aqi_scale_t enums).
- */
-static int (*CALC_AQI_LOOKUP_TABLE[NUM_AQI_SCALES])(
-                          const float[24], const float[24], const float[24],
-                          const float[24], const float[24], const float[24],
-                          const float[24], const float[24], const float[24]) = {
-  calc_australia_aqi,
-  calc_canada_aqhi,
-  calc_china_aqi,
-  calc_european_union_caqi,
-  calc_hong_kong_aqhi,
-  calc_india_aqi,
-  calc_singapore_psi,
-  calc_south_korea_cai,
-  calc_united_kingdom_daqi,
-  calc_united_states_aqi,
-};
-
 int calc_aqi(aqi_scale_t scale,
              const float co[24],  const float nh3[24],  const float no[24],
              const float no2[24], const float o3[24],   const float pb[24],
              const float so2[24], const float pm10[24], const float pm2_5[24])
 {
-  return CALC_AQI_LOOKUP_TABLE[scale](co, nh3, no, no2, o3, pb, so2, pm10,
-                                      pm2_5);
+  aqi_conc_sums_t sums;
+  aqi_conc_sums_init(&sums, co, nh3, no, no2, o3, pb, so2, pm10, pm2_5);
+  return SUMS_AQI_LOOKUP_TABLE[scale](&sums);
 } // end calc_aqi
 
+int calc_aqi_sums(aqi_scale_t scale, const aqi_conc_sums_t *sums)
+{
+  return SUMS_AQI_LOOKUP_TABLE[scale](sums);
+} // end calc_aqi_sums
+
+void calc_aqi_batch(const aqi_scale_t *scales, int num_scales, int *aqi,
+             const float co[24],  const float nh3[24],  const float no[24],
+             const float no2[24], const float o3[24],   const float pb[24],
+             const float so2[24], const float pm10[24], const float pm2_5[24])
+{
+  aqi_conc_sums_t sums;
+  aqi_conc_sums_init(&sums, co, nh3, no, no2, o3, pb, so2, pm10, pm2_5);
+  for (int i = 0; i < num_scales; ++i)
+  {
+    aqi[i] = SUMS_AQI_LOOKUP_TABLE[scales[i]](&sums);
+  }
+} // end calc_aqi_batch
+
 /* Fast lookup for AQI scale max values. Organized alphabetically
  * (same order as aqi_scale_t enums).
  */
@@ -2918,3 +2075,4 @@ aqi_desc_type_t aqi_desc_type(aqi_scale_t scale)
 {
   return AQI_DESC_TYPE_LOOKUP_TABLE[scale];
 } // aqi_desc_type
+
@@ -20,6 +20,8 @@
 #ifndef __AQI_H__
 #define __AQI_H__
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -166,6 +168,101 @@ int calc_aqi(aqi_scale_t scale,
              const float no2[24], const float o3[24],   const float pb[24],
              const float so2[24], const float pm10[24], const float pm2_5[24]);
 
+/* Pollutants, in the same order as the calc_* parameters.
+ */
+typedef enum {
+  AQI_CO,
+  AQI_NH3,
+  AQI_NO,
+  AQI_NO2,
+  AQI_O3,
+  AQI_PB,
+  AQI_SO2,
+  AQI_PM10,
+  AQI_PM2_5,
+  NUM_AQI_POLLUTANTS
+} aqi_pollutant_t;
+
+/* Define AQI_FIXED_POINT (e.g. with a build flag) on targets without a floating
+ * point unit. The piecewise scales are then evaluated with integer arithmetic,
+ * on concentrations in units of 1/AQI_FIXED_SCALE μg/m^3. The Canada and Hong
+ * Kong scales are exponential, and are always evaluated in floating point.
+ *
+ * NaN and infinite concentrations give the same results in both builds, the
+ * ones the library has always given on x86 hosts: NaN and +INFINITY overflow a
+ * table, -INFINITY falls in its lowest band, and none of them raise the
+ * Australia index. The US scale reads NaN and infinite NO2, SO2 and PM10 as the
+ * lowest band.
+ */
+#ifdef AQI_FIXED_POINT
+#define AQI_FIXED_SCALE 10000
+typedef int64_t aqi_sum_t;
+#else
+typedef double aqi_sum_t;
+#endif
+
+/* Running sums of hourly pollutant concentration samples.
+ *
+ * sum[p] is a ring buffer of the cumulative concentration of pollutant p,
+ * 'head' is the entry that includes the most recent sample. The average
+ * concentration over the most recent X hours is
+ *   (sum[p][head] - sum[p][head - X]) / X
+ * Each sample is summed once, no matter how many averaging periods or scales
+ * are evaluated, and a new hour of samples can be added without re-summing the
+ * rest.
+ *
+ * NaN and infinite samples are not summed, nonfinite[p] holds the cumulative
+ * counts of each kind (modulo 256). An average over hours that include one is
+ * what adding the samples gives: NaN if they include a NaN or both infinities,
+ * otherwise the infinity they include.
+ */
+#define AQI_SUMS_LEN (24 + 1)
+typedef struct {
+  uint8_t nan, inf, neg_inf;
+} aqi_nonfinite_t;
+typedef struct {
+  aqi_sum_t sum[NUM_AQI_POLLUTANTS][AQI_SUMS_LEN];
+  aqi_nonfinite_t nonfinite[NUM_AQI_POLLUTANTS][AQI_SUMS_LEN];
+  int head;
+} aqi_conc_sums_t;
+
+void aqi_conc_sums_init(aqi_conc_sums_t *sums,
+             const float co[24],  const float nh3[24],  const float no[24],
+             const float no2[24], const float o3[24],   const float pb[24],
+             const float so2[24], const float pm10[24], const float pm2_5[24]);
+float aqi_conc_avg(const aqi_conc_sums_t *sums, aqi_pollutant_t pollutant,
+                   int hours);
+
+/* Incremental updates, for when only the most recent hour has changed.
+ *
+ * aqi_conc_sums_update_latest replaces the most recent sample of one
+ * pollutant, for example when the current hour's reading is revised.
+ * aqi_conc_sums_push_hour appends a new hour of samples for every pollutant
+ * (indexed by aqi_pollutant_t) and drops the oldest.
+ */
+void aqi_conc_sums_update_latest(aqi_conc_sums_t *sums,
+                                 aqi_pollutant_t pollutant, float conc);
+void aqi_conc_sums_push_hour(aqi_conc_sums_t *sums,
+                             const float conc[NUM_AQI_POLLUTANTS]);
+
+/* Given a scale and running sums of hourly pollutant concentrations returns the
+ * Air Quality Index.
+ */
+int calc_aqi_sums(aqi_scale_t scale, const aqi_conc_sums_t *sums);
+
+/* Evaluates several scales over the same hourly pollutant concentrations,
+ * averaging each pollutant only once. aqi[i] is set to the index of scales[i].
+ *
+ * Usage Example:
+ *   aqi_scale_t scales[] = {UNITED_STATES_AQI, EUROPEAN_UNION_CAQI};
+ *   int aqi[2];
+ *   calc_aqi_batch(scales, 2, aqi, co, nh3, no, no2, o3, pb, so2, pm10, pm2_5);
+ */
+void calc_aqi_batch(const aqi_scale_t *scales, int num_scales, int *aqi,
+             const float co[24],  const float nh3[24],  const float no[24],
+             const float no2[24], const float o3[24],   const float pb[24],
+             const float so2[24], const float pm10[24], const float pm2_5[24]);
+
 /* Each AQI scale has a maximum value, above which AQI is typically denoted by
  * ">{AQI_MAX}" or "{AQI_MAX}+".
  */
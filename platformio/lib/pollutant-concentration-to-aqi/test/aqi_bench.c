@@ -0,0 +1,813 @@
+/* Host benchmark and golden output check for pollutant-concentration-to-aqi.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+/* Usage:
+ *   aqi_bench bench                    time calc_aqi and the direct functions
+ *   aqi_bench golden  <file>           write the results of every case
+ *   aqi_bench check   <file> [tol]     compare the results to a golden file,
+ *                                      fails if any result differs by more
+ *                                      than tol (default 0)
+ *
+ * The cases are deterministic: every argument of every direct function swept
+ * on its own from 0 to past the top of its scale, a few sweeps with a second
+ * argument held where the scale picks between two averaging periods, random
+ * arguments for every direct function, random 24 hour series through
+ * calc_aqi for every scale, the same kind of series through calc_aqi_batch,
+ * running sums advanced an hour at a time and revised with
+ * aqi_conc_sums_push_hour and aqi_conc_sums_update_latest, and NaN and
+ * infinite arguments and samples. The
+ * Canada and Hong Kong scales are left out of the last, they are exponential
+ * and evaluated in floating point in both builds.
+ *
+ * The results of calc_aqi_batch and of the running sums must also equal those
+ * of calc_aqi on the same series exactly, in either build.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "aqi.h"
+
+#define SWEEP_STEPS    8192
+#define RANDOM_DIRECT  2000
+#define RANDOM_SERIES  1000
+#define BATCH_SERIES   200
+#define INCREMENTAL    16
+#define BENCH_SERIES   512
+#define MAX_REPORTED   8
+
+/* aqi.h defines AQI_EXTERN_TXT, the firmware defines the descriptors in its
+ * locales.
+ */
+const char *const AUSTRALIA_AQI_TXT[6];
+const char *const CANADA_AQHI_TXT[4];
+const char *const CHINA_AQI_TXT[6];
+const char *const EUROPEAN_UNION_CAQI_TXT[5];
+const char *const HONG_KONG_AQHI_TXT[5];
+const char *const INDIA_AQI_TXT[6];
+const char *const SINGAPORE_PSI_TXT[5];
+const char *const SOUTH_KOREA_CAI_TXT[4];
+const char *const UNITED_KINGDOM_DAQI_TXT[4];
+const char *const UNITED_STATES_AQI_TXT[6];
+
+static const char *SCALE_NAMES[NUM_AQI_SCALES] = {
+  "australia", "canada", "china", "european_union", "hong_kong", "india",
+  "singapore", "south_korea", "united_kingdom", "united_states"
+};
+
+/* Arguments of the direct functions, in order.
+ */
+typedef struct {
+  int         nargs;
+  const char *args[10];
+} direct_fn_t;
+
+static const direct_fn_t DIRECT_FNS[NUM_AQI_SCALES] = {
+  {7,  {"co_8h", "no2_1h", "o3_1h", "o3_4h", "so2_1h", "pm10_24h",
+        "pm2_5_24h"}},
+  {3,  {"no2_3h", "o3_3h", "pm2_5_3h"}},
+  {10, {"co_1h", "co_24h", "no2_1h", "no2_24h", "o3_1h", "o3_8h", "so2_1h",
+        "so2_24h", "pm10_24h", "pm2_5_24h"}},
+  {4,  {"no2_1h", "o3_1h", "pm10_1h", "pm2_5_1h"}},
+  {5,  {"no2_3h", "o3_3h", "so2_3h", "pm10_3h", "pm2_5_3h"}},
+  {8,  {"co_8h", "nh3_24h", "no2_24h", "o3_8h", "pb_24h", "so2_24h",
+        "pm10_24h", "pm2_5_24h"}},
+  {7,  {"co_8h", "no2_1h", "o3_1h", "o3_8h", "so2_24h", "pm10_24h",
+        "pm2_5_24h"}},
+  {6,  {"co_1h", "no2_1h", "o3_1h", "so2_1h", "pm10_24h", "pm2_5_24h"}},
+  {5,  {"no2_1h", "o3_8h", "so2_15min", "pm10_24h", "pm2_5_24h"}},
+  {8,  {"co_8h", "no2_1h", "o3_1h", "o3_8h", "so2_1h", "so2_24h", "pm10_24h",
+        "pm2_5_24h"}},
+};
+
+/* Sweep range of each pollutant, in μg/m^3. Every range is a power of two so
+ * the sweep steps are exact, and reaches past the top of every scale.
+ */
+typedef struct {
+  const char *prefix;
+  float       range;
+} pollutant_range_t;
+
+static const pollutant_range_t RANGES[] = {
+  {"co",    65536.f},
+  {"nh3",    4096.f},
+  {"no2",    4096.f},
+  {"o3",     2048.f},
+  {"pb",        8.f},
+  {"so2",   16384.f},
+  {"pm10",   1024.f},
+  {"pm2_5",  1024.f},
+};
+
+/* Sweeps of one argument with another held, where a scale picks between two
+ * averaging periods of the same pollutant.
+ */
+typedef struct {
+  aqi_scale_t scale;
+  int         arg;
+  float       lo;
+  float       hi;
+  int         held_arg;
+  float       held;
+} paired_sweep_t;
+
+static const paired_sweep_t PAIRED_SWEEPS[] = {
+  {UNITED_STATES_AQI, 3, 384.f, 400.f,   2, 229.f},  // o3_8h,   o3_1h
+  {UNITED_STATES_AQI, 2, 0.f,   2048.f,  3, 400.f},  // o3_1h,   o3_8h
+  {UNITED_STATES_AQI, 4, 0.f,   2048.f,  5, 1024.f}, // so2_1h,  so2_24h
+  {CHINA_AQI,         5, 0.f,   2048.f,  4, 400.f},  // o3_8h,   o3_1h
+  {CHINA_AQI,         6, 0.f,   4096.f,  7, 512.f},  // so2_1h,  so2_24h
+  {SINGAPORE_PSI,     3, 0.f,   2048.f,  2, 400.f},  // o3_8h,   o3_1h
+  {SINGAPORE_PSI,     1, 1024.f, 1152.f, 0, 0.f},    // no2_1h
+};
+
+static float arg_range(const char *arg)
+{
+  float range = 0.f;
+  size_t best = 0;
+  for (size_t i = 0; i < sizeof(RANGES) / sizeof(RANGES[0]); ++i)
+  {
+    size_t len = strlen(RANGES[i].prefix);
+    if (strncmp(arg, RANGES[i].prefix, len) == 0 && arg[len] == '_'
+        && len > best)
+    {
+      range = RANGES[i].range;
+      best = len;
+    }
+  }
+  return range;
+} // end arg_range
+
+static int call_direct(aqi_scale_t scale, const float *a)
+{
+  switch (scale)
+  {
+  case AUSTRALIA_AQI:
+    return australia_aqi(a[0], a[1], a[2], a[3], a[4], a[5], a[6]);
+  case CANADA_AQHI:
+    return canada_aqhi(a[0], a[1], a[2]);
+  case CHINA_AQI:
+    return china_aqi(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8],
+                     a[9]);
+  case EUROPEAN_UNION_CAQI:
+    return european_union_caqi(a[0], a[1], a[2], a[3]);
+  case HONG_KONG_AQHI:
+    return hong_kong_aqhi(a[0], a[1], a[2], a[3], a[4]);
+  case INDIA_AQI:
+    return india_aqi(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]);
+  case SINGAPORE_PSI:
+    return singapore_psi(a[0], a[1], a[2], a[3], a[4], a[5], a[6]);
+  case SOUTH_KOREA_CAI:
+    return south_korea_cai(a[0], a[1], a[2], a[3], a[4], a[5]);
+  case UNITED_KINGDOM_DAQI:
+    return united_kingdom_daqi(a[0], a[1], a[2], a[3], a[4]);
+  case UNITED_STATES_AQI:
+    return united_states_aqi(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]);
+  default:
+    return -1;
+  }
+} // end call_direct
+
+/* xorshift32, so the cases do not depend on the C library.
+ */
+static uint32_t rng_state;
+
+static uint32_t rng_next(void)
+{
+  uint32_t x = rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return rng_state = x;
+} // end rng_next
+
+/* Returns a uniform float in [0, 1).
+ */
+static float rng_unit(void)
+{
+  return (float) (rng_next() >> 8) / 16777216.f;
+} // end rng_unit
+
+/* Returns a random concentration in [0, range), most of them low.
+ */
+static float rng_conc(float range)
+{
+  float u = rng_unit();
+  return range * u * u * u;
+} // end rng_conc
+
+/* Fills 9 pollutant series of 24 samples. Some pollutants are missing, the
+ * others drift around a random level so the averages differ by period.
+ */
+static void rng_series(float series[9][24], const float **ptrs)
+{
+  static const float POLLUTANT_RANGES[9] = {
+    65536.f, 4096.f, 1024.f, 4096.f, 2048.f, 8.f, 16384.f, 1024.f, 1024.f
+  };
+  for (int p = 0; p < 9; ++p)
+  {
+    float level = rng_conc(POLLUTANT_RANGES[p]);
+    for (int h = 0; h < 24; ++h)
+    {
+      series[p][h] = level * (0.25f + 1.5f * rng_unit());
+    }
+    ptrs[p] = (rng_next() & 15) == 0 ? NULL : series[p];
+  }
+} // end rng_series
+
+/* The results are written run-length encoded, "v" or "v*n", 16 runs per line,
+ * with a '#' line naming each section.
+ */
+typedef enum {
+  MODE_GOLDEN,
+  MODE_CHECK,
+} bench_mode_t;
+
+static bench_mode_t mode;
+static FILE   *golden;
+static int     tolerance;
+
+static int     run_value;
+static long    run_len;
+static int     runs_on_line;
+
+static long    checked;
+static long    mismatches;
+static long    off_by_one;
+static long    failures;
+static int     max_diff;
+static long    section_mismatches;
+static int     reported;
+static long    inconsistent;
+
+static const char *section;
+
+static void flush_run(void)
+{
+  if (run_len == 0)
+  {
+    return;
+  }
+  if (run_len == 1)
+  {
+    fprintf(golden, "%d", run_value);
+  }
+  else
+  {
+    fprintf(golden, "%d*%ld", run_value, run_len);
+  }
+  fputc(++runs_on_line == 16 ? '\n' : ' ', golden);
+  if (runs_on_line == 16)
+  {
+    runs_on_line = 0;
+  }
+  run_len = 0;
+} // end flush_run
+
+/* Returns the next expected result from the golden file, or INT32_MIN at the
+ * end of the file.
+ */
+static int next_expected(void)
+{
+  if (run_len > 0)
+  {
+    --run_len;
+    return run_value;
+  }
+  int c;
+  while ((c = fgetc(golden)) != EOF)
+  {
+    if (c == '#')
+    {
+      while ((c = fgetc(golden)) != EOF && c != '\n')
+      {
+      }
+    }
+    else if (c == '-' || (c >= '0' && c <= '9'))
+    {
+      ungetc(c, golden);
+      long len = 1;
+      if (fscanf(golden, "%d", &run_value) != 1)
+      {
+        break;
+      }
+      if ((c = fgetc(golden)) == '*')
+      {
+        if (fscanf(golden, "%ld", &len) != 1)
+        {
+          break;
+        }
+      }
+      else if (c != EOF)
+      {
+        ungetc(c, golden);
+      }
+      run_len = len - 1;
+      return run_value;
+    }
+  }
+  return INT32_MIN;
+} // end next_expected
+
+static void begin_section(const char *name)
+{
+  section = name;
+  section_mismatches = 0;
+  reported = 0;
+  if (mode == MODE_GOLDEN)
+  {
+    flush_run();
+    if (runs_on_line != 0)
+    {
+      fputc('\n', golden);
+      runs_on_line = 0;
+    }
+    fprintf(golden, "# %s\n", name);
+  }
+} // end begin_section
+
+static void end_section(void)
+{
+  if (mode == MODE_CHECK && section_mismatches > 0)
+  {
+    printf("  %-40s %ld mismatches\n", section, section_mismatches);
+  }
+} // end end_section
+
+/* Records one result. args describes the case for the report.
+ */
+static void emit(int aqi, aqi_scale_t scale, int nargs, const float *args)
+{
+  if (mode == MODE_GOLDEN)
+  {
+    if (run_len > 0 && aqi != run_value)
+    {
+      flush_run();
+    }
+    run_value = aqi;
+    ++run_len;
+    return;
+  }
+
+  int expected = next_expected();
+  ++checked;
+  if (expected == INT32_MIN)
+  {
+    ++failures;
+    return;
+  }
+  if (aqi == expected)
+  {
+    return;
+  }
+  int diff = abs(aqi - expected);
+  ++mismatches;
+  ++section_mismatches;
+  if (diff == 1)
+  {
+    ++off_by_one;
+  }
+  if (diff > max_diff)
+  {
+    max_diff = diff;
+  }
+  if (diff > tolerance)
+  {
+    ++failures;
+    if (reported++ < MAX_REPORTED)
+    {
+      printf("  %s %s(", section, SCALE_NAMES[scale]);
+      for (int i = 0; i < nargs; ++i)
+      {
+        printf(i ? ", %.9g" : "%.9g", args[i]);
+      }
+      printf(") = %d, expected %d\n", aqi, expected);
+    }
+  }
+} // end emit
+
+/* Records the result of another entry point than calc_aqi, reference is the
+ * result of calc_aqi on the same series and must be equal.
+ */
+static void emit_same(int aqi, int reference, aqi_scale_t scale,
+                      const float latest[9])
+{
+  if (aqi != reference && inconsistent++ < MAX_REPORTED)
+  {
+    printf("  %s %s = %d, calc_aqi %d\n", section, SCALE_NAMES[scale], aqi,
+           reference);
+  }
+  emit(aqi, scale, 9, latest);
+} // end emit_same
+
+static void run_direct_sweeps(void)
+{
+  char name[64];
+  for (int s = 0; s < NUM_AQI_SCALES; ++s)
+  {
+    const direct_fn_t *fn = &DIRECT_FNS[s];
+    for (int k = 0; k < fn->nargs; ++k)
+    {
+      float range = arg_range(fn->args[k]);
+      float a[10] = {0};
+      snprintf(name, sizeof(name), "sweep %s %s", SCALE_NAMES[s],
+               fn->args[k]);
+      begin_section(name);
+      for (int i = 0; i <= SWEEP_STEPS; ++i)
+      {
+        a[k] = range * ((float) i / SWEEP_STEPS);
+        emit(call_direct((aqi_scale_t) s, a), (aqi_scale_t) s, fn->nargs, a);
+      }
+      end_section();
+    }
+  }
+} // end run_direct_sweeps
+
+static void run_paired_sweeps(void)
+{
+  char name[64];
+  for (size_t j = 0; j < sizeof(PAIRED_SWEEPS) / sizeof(PAIRED_SWEEPS[0]);
+       ++j)
+  {
+    const paired_sweep_t *p = &PAIRED_SWEEPS[j];
+    const direct_fn_t *fn = &DIRECT_FNS[p->scale];
+    float a[10] = {0};
+    snprintf(name, sizeof(name), "paired %s %s", SCALE_NAMES[p->scale],
+             fn->args[p->arg]);
+    begin_section(name);
+    a[p->held_arg] = p->held;
+    for (int i = 0; i <= SWEEP_STEPS; ++i)
+    {
+      a[p->arg] = p->lo + (p->hi - p->lo) * ((float) i / SWEEP_STEPS);
+      emit(call_direct(p->scale, a), p->scale, fn->nargs, a);
+    }
+    end_section();
+  }
+} // end run_paired_sweeps
+
+static void run_random_direct(void)
+{
+  char name[64];
+  for (int s = 0; s < NUM_AQI_SCALES; ++s)
+  {
+    const direct_fn_t *fn = &DIRECT_FNS[s];
+    float a[10] = {0};
+    rng_state = 0x9E3779B9u + (uint32_t) s;
+    snprintf(name, sizeof(name), "random %s", SCALE_NAMES[s]);
+    begin_section(name);
+    for (int i = 0; i < RANDOM_DIRECT; ++i)
+    {
+      for (int k = 0; k < fn->nargs; ++k)
+      {
+        a[k] = rng_conc(arg_range(fn->args[k]));
+      }
+      emit(call_direct((aqi_scale_t) s, a), (aqi_scale_t) s, fn->nargs, a);
+    }
+    end_section();
+  }
+} // end run_random_direct
+
+static void run_random_series(void)
+{
+  float series[9][24];
+  const float *p[9];
+  char name[64];
+  for (int s = 0; s < NUM_AQI_SCALES; ++s)
+  {
+    rng_state = 0x2545F491u + (uint32_t) s;
+    snprintf(name, sizeof(name), "series %s", SCALE_NAMES[s]);
+    begin_section(name);
+    for (int i = 0; i < RANDOM_SERIES; ++i)
+    {
+      rng_series(series, p);
+      float latest[9];
+      for (int k = 0; k < 9; ++k)
+      {
+        latest[k] = p[k] ? p[k][23] : 0.f;
+      }
+      emit(calc_aqi((aqi_scale_t) s, p[0], p[1], p[2], p[3], p[4], p[5],
+                    p[6], p[7], p[8]),
+           (aqi_scale_t) s, 9, latest);
+    }
+    end_section();
+  }
+} // end run_random_series
+
+static void run_batch(void)
+{
+  float series[9][24];
+  const float *p[9];
+  aqi_scale_t scales[NUM_AQI_SCALES];
+  int aqi[NUM_AQI_SCALES];
+  rng_state = 0x3C6EF372u;
+  begin_section("batch");
+  for (int i = 0; i < BATCH_SERIES; ++i)
+  {
+    rng_series(series, p);
+    float latest[9];
+    for (int k = 0; k < 9; ++k)
+    {
+      latest[k] = p[k] ? p[k][23] : 0.f;
+    }
+    // 1 to all of the scales, starting from a different one every time
+    int n = 1 + i % NUM_AQI_SCALES;
+    for (int s = 0; s < n; ++s)
+    {
+      scales[s] = (aqi_scale_t) ((s + i / NUM_AQI_SCALES) % NUM_AQI_SCALES);
+    }
+    calc_aqi_batch(scales, n, aqi, p[0], p[1], p[2], p[3], p[4], p[5], p[6],
+                   p[7], p[8]);
+    for (int s = 0; s < n; ++s)
+    {
+      emit_same(aqi[s], calc_aqi(scales[s], p[0], p[1], p[2], p[3], p[4],
+                                 p[5], p[6], p[7], p[8]),
+                scales[s], latest);
+    }
+  }
+  end_section();
+} // end run_batch
+
+static void run_incremental(void)
+{
+  float first[9][24];
+  float next[9][24];
+  float hours[9][48];
+  const float *p[9];
+  const float *window[9];
+  aqi_conc_sums_t sums;
+  rng_state = 0xA54FF53Au;
+  begin_section("incremental");
+  for (int i = 0; i < INCREMENTAL; ++i)
+  {
+    // 48 hours, a missing pollutant stays 0
+    rng_series(first, p);
+    rng_series(next, window);
+    for (int k = 0; k < 9; ++k)
+    {
+      for (int h = 0; h < 24; ++h)
+      {
+        hours[k][h] = p[k] ? first[k][h] : 0.f;
+        hours[k][24 + h] = p[k] ? next[k][h] : 0.f;
+      }
+      window[k] = hours[k];
+    }
+    aqi_conc_sums_init(&sums, window[0], window[1], window[2], window[3],
+                       window[4], window[5], window[6], window[7], window[8]);
+
+    // push the next 24 hours one at a time, and revise each new hour once
+    for (int step = 1; step <= 24; ++step)
+    {
+      float conc[NUM_AQI_POLLUTANTS];
+      float latest[9];
+      for (int k = 0; k < 9; ++k)
+      {
+        conc[k] = hours[k][23 + step];
+        window[k] = hours[k] + step;
+      }
+      for (int update = 0; update <= 1; ++update)
+      {
+        if (update)
+        {
+          int q = rng_next() % NUM_AQI_POLLUTANTS;
+          hours[q][23 + step] *= 0.25f + 1.5f * rng_unit();
+          aqi_conc_sums_update_latest(&sums, (aqi_pollutant_t) q,
+                                      hours[q][23 + step]);
+        }
+        else
+        {
+          aqi_conc_sums_push_hour(&sums, conc);
+        }
+        for (int k = 0; k < 9; ++k)
+        {
+          latest[k] = window[k][23];
+        }
+        for (int s = 0; s < NUM_AQI_SCALES; ++s)
+        {
+          emit_same(calc_aqi_sums((aqi_scale_t) s, &sums),
+                    calc_aqi((aqi_scale_t) s, window[0], window[1], window[2],
+                             window[3], window[4], window[5], window[6],
+                             window[7], window[8]),
+                    (aqi_scale_t) s, latest);
+        }
+      }
+    }
+  }
+  end_section();
+} // end run_incremental
+
+static int is_exponential(aqi_scale_t scale)
+{
+  return scale == CANADA_AQHI || scale == HONG_KONG_AQHI;
+} // end is_exponential
+
+static void run_nonfinite(void)
+{
+  static const float VALUES[] = {NAN, INFINITY, -INFINITY};
+  float series[9][24];
+  const float *p[9];
+  char name[64];
+  for (int s = 0; s < NUM_AQI_SCALES; ++s)
+  {
+    if (is_exponential((aqi_scale_t) s))
+    {
+      continue;
+    }
+    const direct_fn_t *fn = &DIRECT_FNS[s];
+    snprintf(name, sizeof(name), "nonfinite %s", SCALE_NAMES[s]);
+    begin_section(name);
+    // each argument in turn, the others 0 or at 1/16 of their range
+    for (int level = 0; level <= 1; ++level)
+    {
+      for (int k = 0; k < fn->nargs; ++k)
+      {
+        for (size_t v = 0; v < sizeof(VALUES) / sizeof(VALUES[0]); ++v)
+        {
+          float a[10] = {0};
+          for (int j = 0; j < fn->nargs; ++j)
+          {
+            a[j] = level * arg_range(fn->args[j]) / 16;
+          }
+          a[k] = VALUES[v];
+          emit(call_direct((aqi_scale_t) s, a), (aqi_scale_t) s, fn->nargs,
+               a);
+        }
+      }
+    }
+    // one sample of one pollutant, in the oldest, an older and the latest hour
+    rng_state = 0xBB67AE85u + (uint32_t) s;
+    for (int pollutant = 0; pollutant < 9; ++pollutant)
+    {
+      static const int HOURS[] = {0, 16, 23};
+      for (size_t h = 0; h < sizeof(HOURS) / sizeof(HOURS[0]); ++h)
+      {
+        for (size_t v = 0; v < sizeof(VALUES) / sizeof(VALUES[0]); ++v)
+        {
+          rng_series(series, p);
+          p[pollutant] = series[pollutant];
+          series[pollutant][HOURS[h]] = VALUES[v];
+          float latest[9];
+          for (int k = 0; k < 9; ++k)
+          {
+            latest[k] = p[k] ? p[k][23] : 0.f;
+          }
+          emit(calc_aqi((aqi_scale_t) s, p[0], p[1], p[2], p[3], p[4], p[5],
+                        p[6], p[7], p[8]),
+               (aqi_scale_t) s, 9, latest);
+        }
+      }
+    }
+    end_section();
+  }
+} // end run_nonfinite
+
+static void run_cases(void)
+{
+  run_direct_sweeps();
+  run_paired_sweeps();
+  run_random_direct();
+  run_random_series();
+  run_batch();
+  run_incremental();
+  run_nonfinite();
+} // end run_cases
+
+static double now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+} // end now_ns
+
+static void bench(void)
+{
+  static float series[BENCH_SERIES][9][24];
+  static const float *ptrs[BENCH_SERIES][9];
+  static float direct[BENCH_SERIES][10];
+  volatile int sink = 0;
+
+  rng_state = 0x6A09E667u;
+  for (int i = 0; i < BENCH_SERIES; ++i)
+  {
+    rng_series(series[i], ptrs[i]);
+  }
+
+  printf("%-16s %14s %14s\n", "scale", "calc_aqi ns", "direct ns");
+  for (int s = 0; s < NUM_AQI_SCALES; ++s)
+  {
+    const direct_fn_t *fn = &DIRECT_FNS[s];
+    for (int i = 0; i < BENCH_SERIES; ++i)
+    {
+      for (int k = 0; k < fn->nargs; ++k)
+      {
+        direct[i][k] = rng_conc(arg_range(fn->args[k]));
+      }
+    }
+
+    int reps = 200;
+    double t0 = now_ns();
+    for (int r = 0; r < reps; ++r)
+    {
+      for (int i = 0; i < BENCH_SERIES; ++i)
+      {
+        const float **p = ptrs[i];
+        sink += calc_aqi((aqi_scale_t) s, p[0], p[1], p[2], p[3], p[4], p[5],
+                         p[6], p[7], p[8]);
+      }
+    }
+    double series_ns = (now_ns() - t0) / ((double) reps * BENCH_SERIES);
+
+    reps = 2000;
+    t0 = now_ns();
+    for (int r = 0; r < reps; ++r)
+    {
+      for (int i = 0; i < BENCH_SERIES; ++i)
+      {
+        sink += call_direct((aqi_scale_t) s, direct[i]);
+      }
+    }
+    double direct_ns = (now_ns() - t0) / ((double) reps * BENCH_SERIES);
+
+    printf("%-16s %14.1f %14.1f\n", SCALE_NAMES[s], series_ns, direct_ns);
+  }
+  (void) sink;
+} // end bench
+
+int main(int argc, char **argv)
+{
+  if (argc >= 2 && strcmp(argv[1], "bench") == 0)
+  {
+    bench();
+    return 0;
+  }
+  if (argc < 3 || (strcmp(argv[1], "golden") != 0
+                   && strcmp(argv[1], "check") != 0))
+  {
+    fprintf(stderr, "usage: %s bench | golden <file> | check <file> [tol]\n",
+            argv[0]);
+    return 2;
+  }
+
+  mode = strcmp(argv[1], "golden") == 0 ? MODE_GOLDEN : MODE_CHECK;
+  golden = fopen(argv[2], mode == MODE_GOLDEN ? "w" : "r");
+  if (golden == NULL)
+  {
+    perror(argv[2]);
+    return 2;
+  }
+  tolerance = argc >= 4 ? atoi(argv[3]) : 0;
+
+  if (mode == MODE_GOLDEN)
+  {
+    fprintf(golden, "# aqi_bench golden results, regenerate with "
+                    "'make golden'\n");
+  }
+  run_cases();
+  if (mode == MODE_GOLDEN)
+  {
+    flush_run();
+    if (runs_on_line != 0)
+    {
+      fputc('\n', golden);
+    }
+    fclose(golden);
+    return inconsistent > 0;
+  }
+
+  int trailing = failures == 0 && next_expected() != INT32_MIN;
+  fclose(golden);
+  printf("%ld results, %ld mismatches (%ld off by 1, max %d)%s\n",
+         checked, mismatches, off_by_one, max_diff,
+         trailing ? ", golden file has more results" : "");
+  if (inconsistent > 0)
+  {
+    printf("FAIL: %ld results differ from calc_aqi\n", inconsistent);
+    return 1;
+  }
+  if (failures > 0 || trailing)
+  {
+    printf("FAIL: %ld results differ by more than %d\n", failures, tolerance);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+} // end main
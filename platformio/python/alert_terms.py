@@ -0,0 +1,142 @@
+"""
+Generates the alert terminology matcher for the selected locale.
+
+The ALERT_URGENCY and TERM_* keyword lists of the locale are compiled into an
+Aho-Corasick automaton, so that the urgency and category of an alert can be
+found with a single pass over its event text. The automaton is written as
+constant tables to a header that is included by display_utils.cpp.
+"""
+
+import re
+
+HEADER_NAME = "alert_terms.h"
+
+def _parse_c_string(body: str) -> bytes:
+    """Decodes the escape sequences of a C string literal body."""
+    out = bytearray()
+    i = 0
+    while i < len(body):
+        c = body[i]
+        if c != '\\':
+            out += c.encode("utf-8")
+            i += 1
+            continue
+        i += 1
+        c = body[i]
+        if c in "01234567":
+            m = re.match(r"[0-7]{1,3}", body[i:])
+            out.append(int(m.group(0), 8))
+            i += len(m.group(0))
+        elif c == 'x':
+            m = re.match(r"[0-9a-fA-F]+", body[i + 1:])
+            out.append(int(m.group(0), 16) & 0xff)
+            i += 1 + len(m.group(0))
+        else:
+            out += {'n': b'\n', 't': b'\t', 'r': b'\r'}.get(c, c.encode())
+            i += 1
+    return bytes(out)
+
+def _parse_list(source: str, name: str) -> list:
+    """Returns the strings of the (uncommented) array definition 'name'."""
+    m = re.search(r"^const char \*const " + name + r"\[\]\s*=\s*\{([^}]*)\}",
+                  source, re.M)
+    if m is None:
+        raise ValueError(f"{name} is not defined")
+    return [_parse_c_string(s) for s in re.findall(r'"((?:[^"\\]|\\.)*)"',
+                                                   m.group(1))]
+
+def _parse_categories(display_utils_h: str) -> list:
+    """Returns the members of enum alert_category, in order."""
+    body = re.search(r"enum alert_category\s*\{([^}]*)\}", display_utils_h)
+    members = [m.split('=')[0].strip() for m in body.group(1).split(',')]
+    return [m for m in members if m and m != "NOT_FOUND"]
+
+def _build(patterns: list):
+    """
+    Builds the automaton. patterns is a list of (bytes, output bit, is
+    urgency). Returns (edges, fail, category, urgency) where edges[n] is a
+    sorted list of (byte, next node).
+    """
+    goto = [{}]
+    out_cat = [0]
+    out_urg = [0]
+    for text, bit, is_urgency in patterns:
+        node = 0
+        for b in text:
+            if b not in goto[node]:
+                goto.append({})
+                out_cat.append(0)
+                out_urg.append(0)
+                goto[node][b] = len(goto) - 1
+            node = goto[node][b]
+        if is_urgency:
+            out_urg[node] |= 1 << bit
+        else:
+            out_cat[node] |= 1 << bit
+
+    # breadth first, so that fail links always point to an earlier node and
+    # outputs can be merged along them
+    fail = [0] * len(goto)
+    queue = list(goto[0].values())
+    while queue:
+        node = queue.pop(0)
+        for b, child in goto[node].items():
+            f = fail[node]
+            while f and b not in goto[f]:
+                f = fail[f]
+            fail[child] = goto[f].get(b, 0)
+            out_cat[child] |= out_cat[fail[child]]
+            out_urg[child] |= out_urg[fail[child]]
+            queue.append(child)
+
+    edges = [sorted(g.items()) for g in goto]
+    return edges, fail, out_cat, out_urg
+
+def _array(ctype: str, name: str, values: list) -> str:
+    lines = []
+    for i in range(0, len(values), 12):
+        lines.append("  " + ", ".join(str(v) for v in values[i:i + 12]) + ",")
+    return (f"static const {ctype} {name}[{len(values)}] =\n{{\n"
+            + "\n".join(lines) + "\n};\n")
+
+def generate(locale_path: str, display_utils_h_path: str, out_path: str):
+    with open(locale_path, "r", encoding="utf-8") as f:
+        source = f.read()
+    with open(display_utils_h_path, "r", encoding="utf-8") as f:
+        categories = _parse_categories(f.read())
+
+    urgency = _parse_list(source, "ALERT_URGENCY")
+    if len(urgency) > 16:
+        raise ValueError("ALERT_URGENCY may have at most 16 keywords")
+    if len(categories) > 32:
+        raise ValueError("enum alert_category may have at most 32 members")
+
+    patterns = [(t, i, True) for i, t in enumerate(urgency)]
+    for i, category in enumerate(categories):
+        patterns += [(t, i, False)
+                     for t in _parse_list(source, "TERM_" + category)]
+    edges, fail, out_cat, out_urg = _build(patterns)
+
+    edge_start = [0]
+    edge_char = []
+    edge_next = []
+    for node_edges in edges:
+        for b, child in node_edges:
+            edge_char.append(b)
+            edge_next.append(child)
+        edge_start.append(len(edge_char))
+
+    with open(out_path, "w", encoding="utf-8", newline="\n") as f:
+        f.write("/* Generated by python/alert_terms.py from "
+                + locale_path.replace("\\", "/").split("/")[-1]
+                + ". Do not edit.\n */\n\n")
+        f.write("#ifndef __ALERT_TERMS_H__\n#define __ALERT_TERMS_H__\n\n")
+        f.write("#include <stdint.h>\n\n")
+        f.write(f"#define ALERT_TERMS_NUM_NODES {len(edges)}\n\n")
+        f.write(_array("uint16_t", "ALERT_TERMS_EDGE_START", edge_start))
+        f.write(_array("uint8_t", "ALERT_TERMS_EDGE_CHAR", edge_char or [0]))
+        f.write(_array("uint16_t", "ALERT_TERMS_EDGE_NEXT", edge_next or [0]))
+        f.write(_array("uint16_t", "ALERT_TERMS_FAIL", fail))
+        f.write(_array("uint32_t", "ALERT_TERMS_CATEGORY", out_cat))
+        f.write(_array("uint16_t", "ALERT_TERMS_URGENCY", out_urg))
+        f.write("\n#endif\n")
@@ -173,22 +173,30 @@ class ConfigSchema(BaseModel):
     posVisibility: int | None = 7
     posInTemp: int | None = 8
     posInHumidity: int | None = 9
+    posInIAQ: int | None = None # requires the BME680
     posMoonrise: int | None = None
     posMoonset: int | None = None
     posMoonphase: int | None = None
     posDewPoint: int | None = None
     invertMoonphaseColor: bool = False
     font: Font = Font.FREESANS
+    fontSubsetting: bool = True # only the glyphs that can be drawn
     tempOrderHL: bool = False
     displayDailyPrecip: DisplayDailyPrecip = DisplayDailyPrecip.PRECIP_SMART
     displayHourlyIcons: bool = True
     displayAlerts: bool = True
+    displayIndoorHistory: bool = False
     statusBarExtrasBatPercentage: bool = True
     statusBarExtrasBatVoltage: bool = False
     statusBarExtrasWifiStrength: bool = True
     statusBarExtrasWifiRSSI: bool = False
+    statusBarExtrasBatLife: bool = False
     batteryMonitoring: bool = True
+    powerTiers: bool = False
+    ulpBatteryMonitoring: bool = False
     debugLevel: int = 0 # TODO: From 0 to 2
+    telemetry: bool = False
+    telemetryUrl: str | None = None # http:// endpoint the records are POSTed to
     pinBatAdc: int = 34 # TODO: Manage An nomenclature for analog pins
     pinEpdBusy: int = 14
     pinEpdCS: int = 13
@@ -201,6 +209,7 @@ class ConfigSchema(BaseModel):
     pinBmeSDA: int = 17
     pinBmeSCL: int = 16
     pinBmePwr: int = 4
+    pinTelemetryDump: int = -1 # held low at boot to print telemetry, -1 = none
     bmeAddress: int | str = 0x76
     wifiSSID: str
     wifiPassword: str
@@ -216,6 +225,9 @@ class ConfigSchema(BaseModel):
     dateFormat: str
     refreshTimeFormat: str = "%x %H:%M"
     sleepDuration: int = 30
+    adaptiveSleep: bool = False
+    sleepDurationMin: int = 15
+    sleepDurationMax: int = 120
     bedTime: int = 0
     wakeTime: int = 6
     hourlyGraphMax: int = 24
@@ -231,6 +243,33 @@ class ConfigSchema(BaseModel):
             raise ValueError("The API key is required on OpenWeatherMap")
         return self
 
+    @model_validator(mode="after")
+    def validate_sleep_durations(self):
+        if self.adaptiveSleep and not (0 < self.sleepDurationMin
+                                       <= self.sleepDuration
+                                       <= self.sleepDurationMax):
+            raise ValueError("sleepDurationMin <= sleepDuration <= "
+                             "sleepDurationMax is required for adaptiveSleep")
+        return self
+
+    @model_validator(mode="after")
+    def validate_ulp_battery_monitoring(self):
+        if self.ulpBatteryMonitoring and not self.batteryMonitoring:
+            raise ValueError("ulpBatteryMonitoring requires batteryMonitoring")
+        return self
+
+    @model_validator(mode="after")
+    def validate_power_tiers(self):
+        if self.powerTiers and not self.batteryMonitoring:
+            raise ValueError("powerTiers requires batteryMonitoring")
+        return self
+
+    @model_validator(mode="after")
+    def validate_in_iaq(self):
+        if self.posInIAQ is not None and self.sensor != Sensor.BME680:
+            raise ValueError("posInIAQ requires the BME680 sensor")
+        return self
+
 # TODO: JSON Schema
 #main_model_schema = ConfigSchema.model_json_schema()
 #print(json.dumps(main_model_schema, indent=4))
\ No newline at end of file
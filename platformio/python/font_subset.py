@@ -0,0 +1,151 @@
+"""
+Generates a glyph subset of the selected font.
+
+The fonts in lib/esp32-weather-epd-assets are generated by
+fonts/ttf_to_adafruit_gfx.sh with all of ISO-8859-1, at every size. Only the
+sizes referenced by the sources are written to the subset header, and only the
+glyphs of the characters that can be drawn keep their bitmaps: printable ASCII,
+the string literals of the locale and the sources, and the strings of
+config.json (city, date and time formats). The other glyphs keep their advance,
+so a character that was missed is drawn as a blank instead of shifting the
+rest of the text.
+
+Text from the API (alerts) is UTF-8 in any language and is drawn byte by byte,
+so the fonts it is drawn with keep all of 0x80 - 0xFF as well.
+"""
+
+import os
+import re
+
+from alert_terms import _parse_c_string
+
+HEADER_NAME = "font_subset.h"
+
+_LITERAL_OR_COMMENT = re.compile(r'"((?:[^"\\\n]|\\.)*)"|//[^\n]*|/\*.*?\*/',
+                                 re.S)
+_FONT_MACRO = re.compile(r"\bFONT_\d+pt8b(?:_temperature)?\b")
+_GLYPH = re.compile(r"\{\s*(\d+),\s*(\d+),\s*(\d+),\s*(\d+),\s*(-?\d+),"
+                    r"\s*(-?\d+)\s*\}")
+
+def _read(path: str) -> str:
+    # the font headers have Latin-1 characters in their comments, the sources
+    # are UTF-8, and so are their literals once compiled
+    with open(path, "r", encoding="utf-8", errors="replace") as f:
+        return f.read()
+
+def string_literal_chars(paths: list) -> set:
+    """Returns the bytes of the string literals in the C/C++ sources."""
+    chars = set()
+    for path in paths:
+        for m in _LITERAL_OR_COMMENT.finditer(_read(path)):
+            if m.group(1) is not None:
+                chars.update(_parse_c_string(m.group(1)))
+    return chars
+
+def referenced_fonts(paths: list) -> set:
+    """Returns the FONT_* macros used by the C/C++ sources."""
+    fonts = set()
+    for path in paths:
+        fonts.update(_FONT_MACRO.findall(_read(path)))
+    return fonts
+
+def function_fonts(path: str, function: str) -> set:
+    """
+    Returns the FONT_* macros used by a function of a C/C++ source, from its
+    definition to its "// end function" comment.
+    """
+    source = _read(path)
+    m = re.search(r"\b" + function + r"\s*\([^;{]*\)\s*\{(.*?)// end "
+                  + function + r"\b", source, re.S)
+    if m is None:
+        raise ValueError(f"{function} is not defined in {path}")
+    return set(_FONT_MACRO.findall(m.group(1)))
+
+def _parse_font(path: str, name: str):
+    """Returns (bitmaps, glyphs, first, last, y advance) of a font header."""
+    source = _read(path)
+    bitmaps = re.search(name + r"Bitmaps\[\]\s*PROGMEM\s*=\s*\{([^}]*)\}",
+                        source)
+    glyphs = re.search(name + r"Glyphs\[\]\s*PROGMEM\s*=\s*\{(.*?)\}\s*;",
+                       source, re.S)
+    font = re.search(r"GFXfont\s+" + name + r"\s*PROGMEM\s*=\s*\{[^}]*?"
+                     r"(0x[0-9A-Fa-f]+),\s*(0x[0-9A-Fa-f]+),\s*(\d+)\s*\}",
+                     source)
+    if bitmaps is None or glyphs is None or font is None:
+        raise ValueError(f"{path} is not an Adafruit GFX font")
+    return ([int(b, 16) for b in re.findall(r"0x[0-9A-Fa-f]+",
+                                            bitmaps.group(1))],
+            [tuple(int(v) for v in g) for g in _GLYPH.findall(glyphs.group(1))],
+            int(font.group(1), 16), int(font.group(2), 16), int(font.group(3)))
+
+def _subset_font(path: str, name: str, chars: set) -> tuple:
+    """Returns the source of the subset font, and its size before and after."""
+    bitmaps, glyphs, first, last, y_advance = _parse_font(path, name)
+    out_bitmaps = []
+    out_glyphs = []
+    for c, (offset, width, height, x_advance, x_offset, y_offset) \
+            in zip(range(first, last + 1), glyphs):
+        if c in chars:
+            size = (width * height + 7) // 8
+            out_glyphs.append((len(out_bitmaps), width, height, x_advance,
+                               x_offset, y_offset, c))
+            out_bitmaps += bitmaps[offset:offset + size]
+        else:
+            out_glyphs.append((0, 0, 0, x_advance, 0, 0, c))
+    out_bitmaps = out_bitmaps or [0]
+
+    lines = [f"const uint8_t {name}Bitmaps[] PROGMEM = {{"]
+    for i in range(0, len(out_bitmaps), 12):
+        lines.append("  " + ", ".join(f"0x{b:02X}"
+                                      for b in out_bitmaps[i:i + 12]) + ",")
+    lines.append("};\n")
+    lines.append(f"const GFXglyph {name}Glyphs[] PROGMEM = {{")
+    for g in out_glyphs:
+        lines.append("  {{ {:5d}, {:3d}, {:3d}, {:3d}, {:4d}, {:4d} }}, "
+                     "// 0x{:02X}".format(*g))
+    lines.append("};\n")
+    lines.append(f"const GFXfont {name} PROGMEM = {{")
+    lines.append(f"  (uint8_t  *){name}Bitmaps,")
+    lines.append(f"  (GFXglyph *){name}Glyphs,")
+    lines.append(f"  0x{first:02X}, 0x{last:02X}, {y_advance} }};\n")
+    # GFXglyph is 8 bytes with padding, GFXfont is 12 bytes
+    before = len(bitmaps) + 8 * len(glyphs) + 12
+    after = len(out_bitmaps) + 8 * len(out_glyphs) + 12
+    return "\n".join(lines) + "\n", before, after
+
+def generate(font_header_path: str, fonts: set, chars: set, out_path: str,
+             api_fonts: set = frozenset()):
+    """
+    Writes the FONT_* macros in fonts, subset to chars, to out_path. The fonts
+    in api_fonts keep 0x80 - 0xFF too. Returns the size of those fonts before
+    and after, in bytes.
+    """
+    source = _read(font_header_path)
+    # font name -> header, ex. FreeSans_7pt8b -> FreeSans/FreeSans_7pt8b.h
+    includes = {os.path.splitext(os.path.basename(p))[0]: p
+                for p in re.findall(r'#include\s+"([^"]+)"', source)}
+    macros = dict(re.findall(r"#define\s+(FONT_\w+)\s+(\w+)", source))
+    font_dir = os.path.dirname(font_header_path)
+
+    total_before = total_after = 0
+    with open(out_path, "w", encoding="ascii", newline="\n") as f:
+        f.write("/* Generated by python/font_subset.py from "
+                + os.path.basename(font_header_path) + ". Do not edit.\n */\n\n")
+        f.write("#ifndef __FONT_SUBSET_H__\n#define __FONT_SUBSET_H__\n\n")
+        for macro in sorted(fonts,
+                            key=lambda m: int(re.search(r"\d+", m).group(0))):
+            if macro not in macros:
+                raise ValueError(f"{macro} is not defined by "
+                                 f"{font_header_path}")
+            name = macros[macro]
+            font_chars = chars
+            if macro in api_fonts:
+                font_chars = chars | set(range(0x80, 0x100))
+            font, before, after = _subset_font(
+                os.path.join(font_dir, includes[name]), name, font_chars)
+            total_before += before
+            total_after += after
+            f.write(font)
+            f.write(f"#define {macro} {name}\n\n")
+        f.write("#endif\n")
+    return total_before, total_after
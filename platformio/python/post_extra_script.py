@@ -6,7 +6,11 @@ except ImportError:
     env.Execute("$PYTHONEXE -m pip install pydantic")
 
 from configschema import ConfigSchema, defined_enums
+import alert_terms
+import font_subset
+import glob
 import json
+import os
 from re import sub
 
 def upper_snake(s: str):
@@ -63,11 +67,44 @@ with open("./config.json", "r", encoding="utf-8") as config_file:
         else:
             cppDefines[upper_snake(k)] = v
 
+    generated_dir = os.path.join(env.subst("$BUILD_DIR"), "generated")
+    os.makedirs(generated_dir, exist_ok=True)
+    locale_path = f"./include/locales/locale_{config.locale.value}.inc"
+
+    # Subset the font to the sizes used and the characters that can be drawn
+    if config.fontSubsetting:
+        sources = glob.glob("./src/*.cpp") + glob.glob("./include/*.h")
+        chars = set(range(0x20, 0x7F))
+        chars |= font_subset.string_literal_chars(sources + [locale_path])
+        for k,v in config:
+            if type(v) == str:
+                chars.update(v.encode("utf-8"))
+        # alerts are drawn in the language of the issuer
+        api_fonts = set()
+        if config.displayAlerts:
+            api_fonts = font_subset.function_fonts("./src/renderer.cpp",
+                                                   "drawAlerts")
+        before, after = font_subset.generate(
+            os.path.join("./lib/esp32-weather-epd-assets",
+                         font_files[config.font]),
+            font_subset.referenced_fonts(sources), chars,
+            os.path.join(generated_dir, font_subset.HEADER_NAME), api_fonts)
+        cppDefines["FONT_HEADER"] = env.StringifyMacro(font_subset.HEADER_NAME)
+        print(f"Font subset: {after} of {before} bytes")
+
     print("Defines:")
     print(json.dumps(cppDefines, indent=4, ensure_ascii=False))
 
     projenv.Append(CPPDEFINES=cppDefines)
 
+    # Compile the locale's alert terminology into the matcher used by
+    # classifyAlert
+    alert_terms.generate(
+        locale_path,
+        "./include/display_utils.h",
+        os.path.join(generated_dir, alert_terms.HEADER_NAME))
+    projenv.Append(CPPPATH=[generated_dir])
+
 
 
 """
@@ -625,3 +625,273 @@ out:
     return 0;
 } // end _strftime
 
+
+// conversion of a compiled op that is handed to _strftime
+#define OP_INTERPRET '\1'
+
+/* Returns true if conversion c is executed directly by compiled programs.
+ */
+static bool isCompiledConversion(char c)
+{
+  return c != '\0' && strchr("aAbBhdeHIklmMpPSyYjuw%nt", c) != NULL;
+} // end isCompiledConversion
+
+/* Compiles a format string into a program that can be executed by the
+ * strftime_prog_t overload of _strftime.
+ *
+ * If the format is too long or too complex to be compiled, the program will
+ * interpret the format with _strftime instead, so the output is the same
+ * either way.
+ */
+void _strftime_compile(strftime_prog_t &prog, const char *format)
+{
+  prog.format = format;
+  prog.compiled = false;
+  prog.num_ops = 0;
+  if (format == NULL || strlen(format) > UINT8_MAX)
+    return;
+
+  const char *p = format;
+  while (*p)
+  {
+    if (prog.num_ops == STRFTIME_PROG_MAX_OPS)
+      return;
+    strftime_op_t &op = prog.ops[prog.num_ops++];
+    op.start = p - format;
+
+    if (*p != '%')
+    {
+      op.conv = '\0';
+      while (*p && *p != '%')
+        p++;
+      op.len = (p - format) - op.start;
+      continue;
+    }
+
+    // %[+|0][width][E|O]conversion
+    bool plain = true;
+    p++;
+    if (*p == '+' || *p == '0')
+    {
+      plain = false;
+      p++;
+    }
+    for (; isdigit(*p); p++)
+      plain = false;
+    for (; *p == 'E' || *p == 'O'; p++)
+      plain = false;
+    if (*p == '\0')
+      return; // a trailing '%' is left to _strftime
+
+    op.conv = (plain && isCompiledConversion(*p)) ? *p : OP_INTERPRET;
+    p++;
+    op.len = (p - format) - op.start;
+  }
+
+  prog.compiled = true;
+  return;
+} // end _strftime_compile
+
+/* Writes v as two digits, padding values below 10 with pad.
+ */
+static void put2(char *buf, int v, char pad)
+{
+  buf[0] = v >= 10 ? '0' + v / 10 : pad;
+  buf[1] = '0' + v % 10;
+  buf[2] = '\0';
+} // end put2
+
+/* Executes a program compiled by _strftime_compile. The result is the same as
+ * calling _strftime with the format the program was compiled from.
+ */
+size_t _strftime(char *s, size_t maxsize, const strftime_prog_t &prog,
+                 const struct tm *timeptr)
+{
+  if (!prog.compiled)
+    return _strftime(s, maxsize, prog.format, timeptr);
+
+  char *endp = s + maxsize;
+  char *start = s;
+  char tbuf[100];
+  int i;
+
+  if (s == NULL || timeptr == NULL || maxsize == 0)
+    return 0;
+
+  // same as _strftime, a format without conversions must leave room to spare
+  if ((prog.num_ops == 0 || (prog.num_ops == 1 && prog.ops[0].conv == '\0'))
+      && strlen(prog.format) + 1 >= maxsize)
+    return 0;
+
+  for (int op_i = 0; op_i < prog.num_ops; ++op_i)
+  {
+    const strftime_op_t &op = prog.ops[op_i];
+    const char *text = prog.format + op.start;
+
+    if (op.conv == '\0')
+    {
+      for (int j = 0; j < op.len; ++j)
+      {
+        if (s >= endp - 1)
+          return 0;
+        *s++ = text[j];
+      }
+      continue;
+    }
+
+    if (s >= endp - 1)
+      return 0;
+
+    switch (op.conv)
+    {
+    case OP_INTERPRET:
+    {
+      char spec[UINT8_MAX + 1];
+      memcpy(spec, text, op.len);
+      spec[op.len] = '\0';
+      tbuf[0] = '\0';
+      _strftime(tbuf, sizeof(tbuf), spec, timeptr);
+      break;
+    }
+
+    case '%':
+      *s++ = '%';
+      continue;
+
+    case 'a':
+      if (timeptr->tm_wday < 0 || timeptr->tm_wday > 6)
+        strcpy(tbuf, "?");
+      else
+        strcpy(tbuf, LC_ABDAY[timeptr->tm_wday]);
+      break;
+
+    case 'A':
+      if (timeptr->tm_wday < 0 || timeptr->tm_wday > 6)
+        strcpy(tbuf, "?");
+      else
+        strcpy(tbuf, LC_DAY[timeptr->tm_wday]);
+      break;
+
+    case 'b':
+    case 'h':
+      if (timeptr->tm_mon < 0 || timeptr->tm_mon > 11)
+        strcpy(tbuf, "?");
+      else
+        strcpy(tbuf, LC_ABMON[timeptr->tm_mon]);
+      break;
+
+    case 'B':
+      if (timeptr->tm_mon < 0 || timeptr->tm_mon > 11)
+        strcpy(tbuf, "?");
+      else
+        strcpy(tbuf, LC_MON[timeptr->tm_mon]);
+      break;
+
+    case 'd':
+      put2(tbuf, range(1, timeptr->tm_mday, 31), '0');
+      break;
+
+    case 'e':
+      put2(tbuf, range(1, timeptr->tm_mday, 31), ' ');
+      break;
+
+    case 'H':
+      put2(tbuf, range(0, timeptr->tm_hour, 23), '0');
+      break;
+
+    case 'k':
+      put2(tbuf, range(0, timeptr->tm_hour, 23), ' ');
+      break;
+
+    case 'I':
+    case 'l':
+      i = range(0, timeptr->tm_hour, 23);
+      if (i == 0)
+        i = 12;
+      else if (i > 12)
+        i -= 12;
+      put2(tbuf, i, op.conv == 'I' ? '0' : ' ');
+      break;
+
+    case 'j':
+      sprintf(tbuf, "%03d", timeptr->tm_yday + 1);
+      break;
+
+    case 'm':
+      put2(tbuf, range(0, timeptr->tm_mon, 11) + 1, '0');
+      break;
+
+    case 'M':
+      put2(tbuf, range(0, timeptr->tm_min, 59), '0');
+      break;
+
+    case 'n':
+      strcpy(tbuf, "\n");
+      break;
+
+    case 'p':
+    case 'P':
+      i = range(0, timeptr->tm_hour, 23);
+      strcpy(tbuf, i < 12 ? LC_AM_STR : LC_PM_STR);
+      if (op.conv == 'P')
+      {
+        for (i = 0; tbuf[i] != '\0'; ++i)
+          tbuf[i] = tolower(tbuf[i]);
+      }
+      break;
+
+    case 'S':
+      put2(tbuf, range(0, timeptr->tm_sec, 60), '0');
+      break;
+
+    case 't':
+      strcpy(tbuf, "\t");
+      break;
+
+    case 'u':
+      sprintf(tbuf, "%d", timeptr->tm_wday == 0 ? 7 : timeptr->tm_wday);
+      break;
+
+    case 'w':
+      sprintf(tbuf, "%d", range(0, timeptr->tm_wday, 6));
+      break;
+
+    case 'y':
+      sprintf(tbuf, "%02d", timeptr->tm_year % 100);
+      break;
+
+    case 'Y':
+      sprintf(tbuf, "%ld", 1900L + timeptr->tm_year);
+      break;
+    }
+
+    i = strlen(tbuf);
+    if (i)
+    {
+      if (s + i < endp - 1)
+      {
+        strcpy(s, tbuf);
+        s += i;
+      }
+      else
+        return 0;
+    }
+  }
+
+  *s = '\0';
+  return (s - start);
+} // end _strftime
+
+/* Formats the local time of utc, stepping the calendar cal forward (or back)
+ * to it.
+ *
+ * For a series of nearby times, such as the hours of the outlook graph, only
+ * the first call and a call across a daylight saving time transition convert
+ * the time, the others advance the broken-down time of cal in place.
+ */
+size_t _strftime_hours(char *s, size_t maxsize, const strftime_prog_t &prog,
+                       calendar_t &cal, int64_t utc)
+{
+  calendarAdvance(cal, utc);
+  return _strftime(s, maxsize, prog, &cal.local);
+} // end _strftime_hours
@@ -0,0 +1,295 @@
+/* Astronomical calculations for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "astronomy.h"
+
+#include <cmath>
+#include <Arduino.h>
+#include "config.h"
+
+// Unix time of the J2000.0 epoch (2000-01-01 12:00 TT, ignoring delta T)
+#define J2000_UNIX 946728000LL
+#define SECONDS_PER_DAY 86400
+#define DEG_TO_RAD_D (M_PI / 180.0)
+
+/* Ecliptic position of a body, degrees.
+ */
+typedef struct ecliptic
+{
+  double lon;
+  double lat;
+  double parallax;
+} ecliptic_t;
+
+/* Cached results for one day, found by the start of the day. Local midnights
+ * are not a whole number of days apart across a DST change, and two of them can
+ * fall on the same UTC day, so the cache is searched rather than indexed.
+ */
+typedef struct astro_day
+{
+  int64_t dayStart;
+  int64_t sunrise;
+  int64_t sunset;
+  int64_t moonrise;
+  int64_t moonset;
+  float moonPhase;
+} astro_day_t;
+
+RTC_DATA_ATTR static astro_day_t astroCache[OWM_NUM_DAILY];
+
+static double sind(double deg) { return sin(deg * DEG_TO_RAD_D); }
+static double cosd(double deg) { return cos(deg * DEG_TO_RAD_D); }
+
+/* Reduces an angle to the range [0, 360).
+ */
+static double rev(double deg)
+{
+  double r = fmod(deg, 360.0);
+  return r < 0 ? r + 360.0 : r;
+} // end rev
+
+/* Days since J2000.0
+ */
+static double daysSinceJ2000(int64_t t)
+{
+  return (double)(t - J2000_UNIX) / SECONDS_PER_DAY;
+} // end daysSinceJ2000
+
+/* Position of the sun, from the low precision formulae of the Astronomical
+ * Almanac (accurate to about 0.01 degrees between 1950 and 2050).
+ */
+static ecliptic_t sunPosition(double d)
+{
+  double g = rev(357.528 + 0.9856003 * d); // mean anomaly
+  double l = rev(280.460 + 0.9856474 * d); // mean longitude
+  ecliptic_t e;
+  e.lon = rev(l + 1.915 * sind(g) + 0.020 * sind(2 * g));
+  e.lat = 0;
+  e.parallax = 0;
+  return e;
+} // end sunPosition
+
+/* Position of the moon, from the low precision formulae of the Astronomical
+ * Almanac (accurate to about 0.3 degrees).
+ */
+static ecliptic_t moonPosition(double d)
+{
+  double t = d / 36525.0; // Julian centuries
+  ecliptic_t e;
+  e.lon = rev(218.32 + 481267.881 * t
+              + 6.29 * sind(134.9 + 477198.85 * t)
+              - 1.27 * sind(259.2 - 413335.38 * t)
+              + 0.66 * sind(235.7 + 890534.23 * t)
+              + 0.21 * sind(269.9 + 954397.70 * t)
+              - 0.19 * sind(357.5 + 35999.05 * t)
+              - 0.11 * sind(186.6 + 966404.05 * t));
+  e.lat = 5.13 * sind(93.3 + 483202.03 * t)
+          + 0.28 * sind(228.2 + 960400.87 * t)
+          - 0.28 * sind(318.3 + 6003.18 * t)
+          - 0.17 * sind(217.6 - 407332.20 * t);
+  e.parallax = 0.9508
+               + 0.0518 * cosd(134.9 + 477198.85 * t)
+               + 0.0095 * cosd(259.2 - 413335.38 * t)
+               + 0.0078 * cosd(235.7 + 890534.23 * t)
+               + 0.0028 * cosd(269.9 + 954397.70 * t);
+  return e;
+} // end moonPosition
+
+/* Altitude of a body above the horizon, degrees.
+ */
+static double altitude(const ecliptic_t &e, double d, double lat, double lon)
+{
+  // ecliptic to equatorial
+  double eps = 23.439 - 0.0000004 * d;
+  double x = cosd(e.lat) * cosd(e.lon);
+  double y = cosd(eps) * cosd(e.lat) * sind(e.lon) - sind(eps) * sind(e.lat);
+  double z = sind(eps) * cosd(e.lat) * sind(e.lon) + cosd(eps) * sind(e.lat);
+  double ra = atan2(y, x) / DEG_TO_RAD_D;
+  double dec = atan2(z, sqrt(x * x + y * y)) / DEG_TO_RAD_D;
+
+  double lst = rev(280.46061837 + 360.98564736629 * d + lon);
+  double ha = lst - ra;
+  return asin(sind(lat) * sind(dec) + cosd(lat) * cosd(dec) * cosd(ha))
+         / DEG_TO_RAD_D;
+} // end altitude
+
+/* Altitude of the sun's or moon's upper limb relative to the standard rise/set
+ * altitude, accounting for refraction, semi-diameter and, for the moon,
+ * parallax. Positive when the body is up.
+ */
+static double sunHeight(double d, double lat, double lon)
+{
+  return altitude(sunPosition(d), d, lat, lon) + 0.833;
+} // end sunHeight
+
+static double moonHeight(double d, double lat, double lon)
+{
+  ecliptic_t e = moonPosition(d);
+  return altitude(e, d, lat, lon) - (0.7275 * e.parallax - 0.5667);
+} // end moonHeight
+
+/* Finds the rise and set of a body during the 24 hours starting at dayStart.
+ * The height is sampled every hour and each pair of 2 hour intervals is
+ * fitted with a parabola whose roots give the crossings (Montenbruck and
+ * Pfleger, Astronomy on the Personal Computer).
+ */
+static void findRiseSet(double (*height)(double, double, double),
+                        int64_t dayStart, double lat, double lon,
+                        int64_t &rise, int64_t &set)
+{
+  rise = 0;
+  set = 0;
+  const double d0 = daysSinceJ2000(dayStart);
+  double ym = height(d0, lat, lon);
+  for (int hour = 1; hour <= 23; hour += 2)
+  {
+    double y0 = height(d0 + hour / 24.0, lat, lon);
+    double yp = height(d0 + (hour + 1) / 24.0, lat, lon);
+
+    // parabola through (-1, ym), (0, y0), (1, yp)
+    double a = 0.5 * (yp + ym) - y0;
+    double b = 0.5 * (yp - ym);
+    double c = y0;
+    int roots = 0;
+    double z1 = 0, z2 = 0;
+    double ye = c;
+    if (fabs(a) < 1e-9)
+    { // effectively a straight line
+      if (b != 0)
+      {
+        z1 = -c / b;
+        roots = fabs(z1) <= 1 ? 1 : 0;
+      }
+    }
+    else
+    {
+      double xe = -b / (2 * a);
+      ye = (a * xe + b) * xe + c;
+      double dis = b * b - 4 * a * c;
+      if (dis >= 0)
+      {
+        double dx = 0.5 * sqrt(dis) / fabs(a);
+        z1 = xe - dx;
+        z2 = xe + dx;
+        roots = (fabs(z1) <= 1) + (fabs(z2) <= 1);
+        if (z1 < -1)
+        {
+          z1 = z2;
+        }
+      }
+    }
+
+    if (roots == 1)
+    {
+      int64_t t = dayStart + (int64_t)round((hour + z1) * 3600);
+      if (ym < 0)
+      {
+        rise = t;
+      }
+      else
+      {
+        set = t;
+      }
+    }
+    else if (roots == 2)
+    {
+      int64_t t1 = dayStart + (int64_t)round((hour + z1) * 3600);
+      int64_t t2 = dayStart + (int64_t)round((hour + z2) * 3600);
+      rise = ye < 0 ? t2 : t1;
+      set  = ye < 0 ? t1 : t2;
+    }
+    ym = yp;
+  }
+} // end findRiseSet
+
+void calcSunRiseSet(int64_t dayStart, double lat, double lon,
+                    int64_t &rise, int64_t &set)
+{
+  findRiseSet(sunHeight, dayStart, lat, lon, rise, set);
+} // end calcSunRiseSet
+
+void calcMoonRiseSet(int64_t dayStart, double lat, double lon,
+                     int64_t &rise, int64_t &set)
+{
+  findRiseSet(moonHeight, dayStart, lat, lon, rise, set);
+} // end calcMoonRiseSet
+
+/* Returns the moon phase at time t, as the fraction of the synodic month since
+ * new moon. 0 and 1 are new moon, 0.25 first quarter, 0.5 full moon and 0.75
+ * last quarter.
+ */
+float calcMoonPhase(int64_t t)
+{
+  double d = daysSinceJ2000(t);
+  double elongation = rev(moonPosition(d).lon - sunPosition(d).lon);
+  return elongation / 360.0;
+} // end calcMoonPhase
+
+/* Returns the cached day starting at dayStart, or else the slot of the oldest
+ * day cached. The days of a forecast are filled in order, so the oldest day is
+ * one that has passed or that was already filled.
+ */
+static astro_day_t &cachedDay(int64_t dayStart)
+{
+  astro_day_t *oldest = &astroCache[0];
+  for (astro_day_t &day : astroCache)
+  {
+    if (day.dayStart == dayStart)
+    {
+      return day;
+    }
+    if (day.dayStart < oldest->dayStart)
+    {
+      oldest = &day;
+    }
+  }
+  return *oldest;
+} // end cachedDay
+
+void fillAstronomy(owm_resp_onecall_t &r, int days)
+{
+  const double lat = LAT.toDouble();
+  const double lon = LON.toDouble();
+
+  for (int i = 0; i < days && i < OWM_NUM_DAILY; ++i)
+  {
+    const int64_t dayStart = r.daily[i].dt;
+    astro_day_t &day = cachedDay(dayStart);
+    if (day.dayStart != dayStart)
+    {
+      day.dayStart = dayStart;
+      calcSunRiseSet(dayStart, lat, lon, day.sunrise, day.sunset);
+      calcMoonRiseSet(dayStart, lat, lon, day.moonrise, day.moonset);
+      // OpenWeatherMap reports the phase for midday
+      day.moonPhase = calcMoonPhase(dayStart + SECONDS_PER_DAY / 2);
+#if DEBUG_LEVEL >= 1
+      Serial.println("[debug] fillAstronomy computed day "
+                     + String((long)(dayStart / SECONDS_PER_DAY)));
+#endif
+    }
+
+    r.daily[i].moonrise = day.moonrise;
+    r.daily[i].moonset = day.moonset;
+    r.daily[i].moon_phase = day.moonPhase;
+    if (i == 0)
+    {
+      r.current.sunrise = day.sunrise;
+      r.current.sunset = day.sunset;
+    }
+  }
+  return;
+} // end fillAstronomy
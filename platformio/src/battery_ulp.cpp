@@ -0,0 +1,276 @@
+/* Battery ULP program for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "battery_ulp.h"
+
+#if ULP_BATTERY_MONITORING
+
+#include <Arduino.h>
+#include <driver/adc.h>
+#include <esp_sleep.h>
+#include <esp32/ulp.h>
+#include <soc/rtc_cntl_reg.h>
+#include "display_utils.h"
+
+#define BATTERY_ULP_HISTORY 8
+
+// Words of RTC slow memory shared with the ULP program, which is loaded right
+// after them. Only the low 16 bits of each word are used by the ULP.
+enum
+{
+  ULP_LAST,   // last sample, raw
+  ULP_MIN,    // raw
+  ULP_MAX,    // raw
+  ULP_SUM_LO, // sum of the samples, low and high 16 bits
+  ULP_SUM_HI,
+  ULP_COUNT,  // number of samples in the sum, stops at 0xFFFF
+  ULP_LOW,    // wake the CPU below this, raw
+  ULP_HIGH,   // wake the CPU above this, raw
+  ULP_DATA_WORDS
+};
+
+enum
+{
+  L_SUMMED,
+  L_CARRY,
+  L_NEW_MIN,
+  L_MIN_DONE,
+  L_NEW_MAX,
+  L_MAX_DONE,
+  L_WAKE,
+  L_READY
+};
+
+// One entry per deep sleep the ULP sampled, oldest overwritten first.
+RTC_DATA_ATTR static battery_ulp_stats_t batteryUlpHistory[BATTERY_ULP_HISTORY];
+RTC_DATA_ATTR static uint32_t batteryUlpSleeps;
+RTC_DATA_ATTR static bool batteryUlpRunning;
+
+/* Returns the smallest raw ADC reading at or above a battery voltage, the
+ * calibrated conversion has no inverse.
+ */
+static uint32_t voltageToRaw(uint32_t voltage)
+{
+  uint32_t lo = 0;
+  uint32_t hi = 4096;
+  while (lo < hi)
+  {
+    uint32_t mid = (lo + hi) / 2;
+    if (batteryAdcToVoltage(mid) < voltage)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+  return lo;
+} // end voltageToRaw
+
+/* Stops the ULP and moves what it sampled during the last deep sleep into the
+ * history. Call early in setup, before the ULP can request a wake up while the
+ * CPU is already awake.
+ */
+void collectBatteryUlp()
+{
+  if (!batteryUlpRunning)
+  {
+    return;
+  }
+  CLEAR_PERI_REG_MASK(RTC_CNTL_STATE0_REG, RTC_CNTL_ULP_CP_SLP_TIMER_EN);
+  batteryUlpRunning = false;
+
+  const uint32_t count = RTC_SLOW_MEM[ULP_COUNT] & 0xFFFF;
+  if (count == 0)
+  {
+    return;
+  }
+  const uint32_t sum = (RTC_SLOW_MEM[ULP_SUM_HI] & 0xFFFF) << 16
+                       | (RTC_SLOW_MEM[ULP_SUM_LO] & 0xFFFF);
+  battery_ulp_stats_t &s =
+    batteryUlpHistory[batteryUlpSleeps % BATTERY_ULP_HISTORY];
+  s.min_mv = batteryAdcToVoltage(RTC_SLOW_MEM[ULP_MIN] & 0xFFFF);
+  s.max_mv = batteryAdcToVoltage(RTC_SLOW_MEM[ULP_MAX] & 0xFFFF);
+  s.avg_mv = batteryAdcToVoltage(sum / count);
+  s.samples = count;
+  ++batteryUlpSleeps;
+
+#if DEBUG_LEVEL >= 1
+  if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_ULP)
+  {
+    Serial.printf("[debug] Woken by the ULP, battery at %umV\n",
+                  (unsigned) batteryAdcToVoltage(RTC_SLOW_MEM[ULP_LAST]
+                                                 & 0xFFFF));
+  }
+#endif
+  return;
+} // end collectBatteryUlp
+
+/* Starts the ULP sampling the battery every ULP_BATTERY_INTERVAL seconds and
+ * enables it as a wake up source. It wakes the CPU once a sample (the mean of
+ * 4 conversions) falls below lowVoltage or rises above highVoltage, pass 0 or
+ * UINT32_MAX to disable either. Call right before deep sleep.
+ *
+ * Returns false if the ULP could not be started, the caller must then arm
+ * another wake up source.
+ */
+bool startBatteryUlp(uint32_t lowVoltage, uint32_t highVoltage)
+{
+  const int8_t ch = digitalPinToAnalogChannel(PIN_BAT_ADC);
+  if (ch < 0 || ch >= ADC1_CHANNEL_MAX)
+  { // the ULP can only read ADC1
+    Serial.println("ULP not started, PIN_BAT_ADC is not an ADC1 pin");
+    return false;
+  }
+  adc1_config_width(ADC_WIDTH_BIT_12);
+  adc1_config_channel_atten(static_cast<adc1_channel_t>(ch), ADC_ATTEN_11db);
+  adc1_ulp_enable();
+
+  RTC_SLOW_MEM[ULP_LAST] = 0;
+  RTC_SLOW_MEM[ULP_MIN] = 0xFFFF;
+  RTC_SLOW_MEM[ULP_MAX] = 0;
+  RTC_SLOW_MEM[ULP_SUM_LO] = 0;
+  RTC_SLOW_MEM[ULP_SUM_HI] = 0;
+  RTC_SLOW_MEM[ULP_COUNT] = 0;
+  RTC_SLOW_MEM[ULP_LOW] = lowVoltage == 0 ? 0 : voltageToRaw(lowVoltage);
+  RTC_SLOW_MEM[ULP_HIGH] = highVoltage == UINT32_MAX
+                           ? 0xFFFF : voltageToRaw(highVoltage);
+
+  // R1 holds the sample, R3 the base of the shared words. SUBR sets the
+  // overflow flag when it borrows, ie. when the first operand is smaller.
+  const ulp_insn_t program[] = {
+    I_MOVI(R3, 0),
+    I_ADC(R1, 0, ch),
+    I_ADC(R0, 0, ch),
+    I_ADDR(R1, R1, R0),
+    I_ADC(R0, 0, ch),
+    I_ADDR(R1, R1, R0),
+    I_ADC(R0, 0, ch),
+    I_ADDR(R1, R1, R0),
+    I_RSHI(R1, R1, 2),
+    I_ST(R1, R3, ULP_LAST),
+
+    // count and sum
+    I_LD(R0, R3, ULP_COUNT),
+    I_ADDI(R0, R0, 1),
+    M_BXF(L_SUMMED),
+    I_ST(R0, R3, ULP_COUNT),
+    I_LD(R0, R3, ULP_SUM_LO),
+    I_ADDR(R0, R0, R1),
+    I_ST(R0, R3, ULP_SUM_LO),
+    M_BXF(L_CARRY),
+    M_BX(L_SUMMED),
+    M_LABEL(L_CARRY),
+    I_LD(R0, R3, ULP_SUM_HI),
+    I_ADDI(R0, R0, 1),
+    I_ST(R0, R3, ULP_SUM_HI),
+    M_LABEL(L_SUMMED),
+
+    // min and max
+    I_LD(R0, R3, ULP_MIN),
+    I_SUBR(R0, R1, R0),
+    M_BXF(L_NEW_MIN),
+    M_BX(L_MIN_DONE),
+    M_LABEL(L_NEW_MIN),
+    I_ST(R1, R3, ULP_MIN),
+    M_LABEL(L_MIN_DONE),
+    I_LD(R0, R3, ULP_MAX),
+    I_SUBR(R0, R0, R1),
+    M_BXF(L_NEW_MAX),
+    M_BX(L_MAX_DONE),
+    M_LABEL(L_NEW_MAX),
+    I_ST(R1, R3, ULP_MAX),
+    M_LABEL(L_MAX_DONE),
+
+    // thresholds
+    I_LD(R0, R3, ULP_LOW),
+    I_SUBR(R0, R1, R0),
+    M_BXF(L_WAKE),
+    I_LD(R0, R3, ULP_HIGH),
+    I_SUBR(R0, R0, R1),
+    M_BXF(L_WAKE),
+    I_HALT(),
+
+    // a wake up requested while the CPU is awake would be held until it next
+    // sleeps, and wake it right away
+    M_LABEL(L_WAKE),
+    I_RD_REG(RTC_CNTL_LOW_POWER_ST_REG, RTC_CNTL_RDY_FOR_WAKEUP_S,
+             RTC_CNTL_RDY_FOR_WAKEUP_S),
+    M_BGE(L_READY, 1),
+    I_HALT(),
+    M_LABEL(L_READY),
+    I_WAKE(),
+    I_END(), // stop the ULP timer, the CPU restarts it
+    I_HALT(),
+  };
+
+  size_t size = sizeof(program) / sizeof(ulp_insn_t);
+  esp_err_t err = ulp_process_macros_and_load(ULP_DATA_WORDS, program, &size);
+  if (err == ESP_OK)
+  {
+    err = ulp_set_wakeup_period(0, ULP_BATTERY_INTERVAL * 1000000UL);
+  }
+  if (err == ESP_OK)
+  {
+    err = esp_sleep_enable_ulp_wakeup();
+  }
+  if (err == ESP_OK)
+  {
+    err = ulp_run(ULP_DATA_WORDS);
+  }
+  if (err != ESP_OK)
+  {
+    Serial.printf("ULP not started, error %d\n", err);
+    return false;
+  }
+  batteryUlpRunning = true;
+  return true;
+} // end startBatteryUlp
+
+/* Points stats to the stored history of deep sleeps, in no particular order,
+ * and returns how many there are.
+ */
+uint32_t getBatteryUlpHistory(const battery_ulp_stats_t *&stats)
+{
+  stats = batteryUlpHistory;
+  return batteryUlpSleeps < BATTERY_ULP_HISTORY
+         ? batteryUlpSleeps : BATTERY_ULP_HISTORY;
+} // end getBatteryUlpHistory
+
+/* Prints the battery voltage over the last deep sleeps, oldest first.
+ */
+void printBatteryUlpHistory()
+{
+#if DEBUG_LEVEL >= 1
+  const uint32_t n = batteryUlpSleeps < BATTERY_ULP_HISTORY
+                     ? batteryUlpSleeps : BATTERY_ULP_HISTORY;
+  Serial.printf("[debug] %-7s %6s %6s %6s %7s\n",
+                "sleep", "min", "avg", "max", "samples");
+  for (uint32_t seq = batteryUlpSleeps - n; seq < batteryUlpSleeps; ++seq)
+  {
+    const battery_ulp_stats_t &s =
+      batteryUlpHistory[seq % BATTERY_ULP_HISTORY];
+    Serial.printf("[debug] %-7u %6u %6u %6u %7u\n", (unsigned) seq,
+                  s.min_mv, s.avg_mv, s.max_mv, s.samples);
+  }
+  Serial.flush();
+#endif
+  return;
+} // end printBatteryUlpHistory
+
+#endif
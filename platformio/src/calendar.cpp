@@ -0,0 +1,378 @@
+/* Calendar iterator for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "calendar.h"
+
+#include <cctype>
+#include <climits>
+#include "config.h"
+
+#define SECONDS_PER_DAY 86400
+
+/* Returns the largest integer not greater than a / b, for b > 0.
+ */
+static int64_t floorDiv(int64_t a, int64_t b)
+{
+  return a / b - (a % b < 0);
+} // end floorDiv
+
+static bool isLeap(int64_t year)
+{
+  return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+} // end isLeap
+
+static int daysInMonth(int64_t year, int month)
+{
+  static const int8_t mdays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30,
+                                   31};
+  return mdays[month] + (month == 1 && isLeap(year));
+} // end daysInMonth
+
+/* Days since 1970-01-01 of a date in the proleptic Gregorian calendar, month
+ * is 1 - 12.
+ * (Howard Hinnant, chrono-Compatible Low-Level Date Algorithms)
+ */
+static int64_t daysFromCivil(int64_t y, int m, int d)
+{
+  y -= m <= 2;
+  const int64_t era = floorDiv(y, 400);
+  const int64_t yoe = y - era * 400;
+  const int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+} // end daysFromCivil
+
+/* Sets the date fields of t to the given number of days since 1970-01-01.
+ */
+static void civilFromDays(int64_t days, struct tm &t)
+{
+  const int64_t z = days + 719468;
+  const int64_t era = floorDiv(z, 146097);
+  const int64_t doe = z - era * 146097;
+  const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const int64_t mp = (5 * doy + 2) / 153;
+  const int d = doy - (153 * mp + 2) / 5 + 1;
+  const int m = mp < 10 ? mp + 3 : mp - 9;
+  const int64_t y = yoe + era * 400 + (m <= 2);
+
+  t.tm_year = y - 1900;
+  t.tm_mon = m - 1;
+  t.tm_mday = d;
+  t.tm_yday = days - daysFromCivil(y, 1, 1);
+  t.tm_wday = (int)(((days + 4) % 7 + 7) % 7); // 1970-01-01 was a Thursday
+  return;
+} // end civilFromDays
+
+/* Parses the name of a zone, either alphabetic or quoted in <>. Returns a
+ * pointer past the name, or NULL if there is none.
+ */
+static const char *parseName(const char *p)
+{
+  if (*p == '<')
+  {
+    while (*p != '\0' && *p != '>')
+    {
+      ++p;
+    }
+    return *p == '>' ? p + 1 : NULL;
+  }
+  const char *start = p;
+  while (isalpha((unsigned char)*p))
+  {
+    ++p;
+  }
+  return p - start >= 3 ? p : NULL;
+} // end parseName
+
+/* Parses [+|-]hh[:mm[:ss]] into seconds. Returns a pointer past the time, or
+ * NULL if there is none.
+ */
+static const char *parseTime(const char *p, int32_t &seconds)
+{
+  int sign = 1;
+  if (*p == '+' || *p == '-')
+  {
+    sign = *p == '-' ? -1 : 1;
+    ++p;
+  }
+  int32_t fields[3] = {0, 0, 0};
+  for (int i = 0; i < 3; ++i)
+  {
+    if (!isdigit((unsigned char)*p))
+    {
+      return NULL;
+    }
+    while (isdigit((unsigned char)*p))
+    {
+      fields[i] = fields[i] * 10 + (*p++ - '0');
+    }
+    if (*p != ':' || i == 2)
+    {
+      break;
+    }
+    ++p;
+  }
+  seconds = sign * (fields[0] * 3600 + fields[1] * 60 + fields[2]);
+  return p;
+} // end parseTime
+
+/* Parses a number. Returns a pointer past it, or NULL if there is none.
+ */
+static const char *parseNum(const char *p, int &n)
+{
+  if (!isdigit((unsigned char)*p))
+  {
+    return NULL;
+  }
+  n = 0;
+  while (isdigit((unsigned char)*p))
+  {
+    n = n * 10 + (*p++ - '0');
+  }
+  return p;
+} // end parseNum
+
+/* Parses a transition rule, date[/time]. Returns a pointer past the rule, or
+ * NULL if it is invalid.
+ */
+static const char *parseRule(const char *p, tz_rule_t &r)
+{
+  int n = 0;
+  if (*p == 'M')
+  {
+    int w = 0, d = 0;
+    if ((p = parseNum(p + 1, n)) == NULL || *p != '.'
+     || (p = parseNum(p + 1, w)) == NULL || *p != '.'
+     || (p = parseNum(p + 1, d)) == NULL
+     || n < 1 || n > 12 || w < 1 || w > 5 || d > 6)
+    {
+      return NULL;
+    }
+    r.type = 'M';
+    r.month = n;
+    r.week = w;
+    r.day = d;
+  }
+  else
+  {
+    r.type = *p == 'J' ? 'J' : 'D';
+    if ((p = parseNum(p + (r.type == 'J'), n)) == NULL
+     || n > 365 || (r.type == 'J' && n < 1))
+    {
+      return NULL;
+    }
+    r.day = n;
+  }
+
+  r.time = 2 * 3600;
+  if (*p == '/')
+  {
+    p = parseTime(p + 1, r.time);
+  }
+  return p;
+} // end parseRule
+
+/* Parses a POSIX TZ string, ex. "EST5EDT,M3.2.0,M11.1.0". Returns false if
+ * the string is not valid.
+ */
+bool parsePosixTZ(const char *tz, posix_tz_t &z)
+{
+  int32_t offset;
+  const char *p = parseName(tz);
+  if (p == NULL || (p = parseTime(p, offset)) == NULL)
+  {
+    return false;
+  }
+  z.std_offset = -offset; // POSIX offsets are west of UTC
+  z.has_dst = false;
+  if (*p == '\0')
+  {
+    return true;
+  }
+
+  if ((p = parseName(p)) == NULL)
+  {
+    return false;
+  }
+  z.has_dst = true;
+  z.dst_offset = z.std_offset + 3600;
+  if (*p != '\0' && *p != ',')
+  {
+    if ((p = parseTime(p, offset)) == NULL)
+    {
+      return false;
+    }
+    z.dst_offset = -offset;
+  }
+
+  if (*p == '\0')
+  { // no rule, use the United States rules like newlib
+    z.start = {'M', 0, 2, 3, 2 * 3600};
+    z.end = {'M', 0, 1, 11, 2 * 3600};
+    return true;
+  }
+  if (*p != ',' || (p = parseRule(p + 1, z.start)) == NULL
+   || *p != ',' || (p = parseRule(p + 1, z.end)) == NULL)
+  {
+    return false;
+  }
+  return *p == '\0';
+} // end parsePosixTZ
+
+/* Returns the UTC time of a transition in the given year, where offset is the
+ * UTC offset in effect before it.
+ */
+static int64_t transitionTime(const tz_rule_t &r, int64_t year, int32_t offset)
+{
+  int64_t days = daysFromCivil(year, 1, 1);
+  if (r.type == 'J')
+  {
+    days += r.day - 1 + (isLeap(year) && r.day >= 60);
+  }
+  else if (r.type == 'D')
+  {
+    days += r.day;
+  }
+  else
+  {
+    const int64_t first = daysFromCivil(year, r.month, 1);
+    const int firstWday = (int)(((first + 4) % 7 + 7) % 7);
+    int mday = 1 + (r.day - firstWday + 7) % 7 + (r.week - 1) * 7;
+    while (mday > daysInMonth(year, r.month - 1))
+    {
+      mday -= 7;
+    }
+    days = first + mday - 1;
+  }
+  return days * SECONDS_PER_DAY + r.time - offset;
+} // end transitionTime
+
+/* Returns the UTC offset of zone z in effect at UTC time t, in seconds east of
+ * UTC, along with the offset changes surrounding t.
+ */
+int32_t utcOffsetAt(const posix_tz_t &z, int64_t t,
+                    int64_t &prevChange, int64_t &nextChange)
+{
+  if (!z.has_dst)
+  {
+    prevChange = INT64_MIN;
+    nextChange = INT64_MAX;
+    return z.std_offset;
+  }
+
+  struct tm date;
+  civilFromDays(floorDiv(t + z.std_offset, SECONDS_PER_DAY), date);
+  const int64_t year = date.tm_year + 1900LL;
+
+  // the transitions of the surrounding years bound t on both sides
+  bool dst = false;
+  prevChange = INT64_MIN;
+  nextChange = INT64_MAX;
+  for (int64_t y = year - 1; y <= year + 1; ++y)
+  {
+    const int64_t start = transitionTime(z.start, y, z.std_offset);
+    const int64_t end = transitionTime(z.end, y, z.dst_offset);
+    if (start <= t && start > prevChange)
+    {
+      prevChange = start;
+      dst = true;
+    }
+    if (end <= t && end > prevChange)
+    {
+      prevChange = end;
+      dst = false;
+    }
+    if (start > t && start < nextChange)
+    {
+      nextChange = start;
+    }
+    if (end > t && end < nextChange)
+    {
+      nextChange = end;
+    }
+  }
+  return dst ? z.dst_offset : z.std_offset;
+} // end utcOffsetAt
+
+/* The zone of D_TIMEZONE, parsed on first use.
+ */
+static const posix_tz_t *localZone()
+{
+  static posix_tz_t zone;
+  static int8_t parsed = -1;
+  if (parsed < 0)
+  {
+    parsed = parsePosixTZ(D_TIMEZONE, zone);
+  }
+  return parsed ? &zone : NULL;
+} // end localZone
+
+/* Converts utc to local time.
+ */
+void calendarBegin(calendar_t &cal, int64_t utc)
+{
+  cal.utc = utc;
+  const posix_tz_t *zone = localZone();
+  if (zone == NULL)
+  { // not a TZ string we understand, leave it to the C library every time
+    time_t t = utc;
+    localtime_r(&t, &cal.local);
+    cal.utc_offset = 0;
+    cal.prev_change = utc;
+    cal.next_change = utc;
+    return;
+  }
+
+  cal.utc_offset = utcOffsetAt(*zone, utc, cal.prev_change, cal.next_change);
+  const int64_t local = utc + cal.utc_offset;
+  const int64_t days = floorDiv(local, SECONDS_PER_DAY);
+  const int32_t secs = local - days * SECONDS_PER_DAY;
+  civilFromDays(days, cal.local);
+  cal.local.tm_hour = secs / 3600;
+  cal.local.tm_min = secs / 60 % 60;
+  cal.local.tm_sec = secs % 60;
+  cal.local.tm_isdst = zone->has_dst && cal.utc_offset == zone->dst_offset;
+  return;
+} // end calendarBegin
+
+/* Moves the calendar to utc. While no UTC offset change lies in between, the
+ * broken-down time is advanced in place and no conversion is done.
+ */
+void calendarAdvance(calendar_t &cal, int64_t utc)
+{
+  if (utc < cal.prev_change || utc >= cal.next_change)
+  {
+    calendarBegin(cal, utc);
+    return;
+  }
+
+  tm &t = cal.local;
+  int64_t secs = t.tm_hour * 3600 + t.tm_min * 60 + t.tm_sec + (utc - cal.utc);
+  const int64_t days = floorDiv(secs, SECONDS_PER_DAY);
+  secs -= days * SECONDS_PER_DAY;
+  t.tm_hour = secs / 3600;
+  t.tm_min = secs / 60 % 60;
+  t.tm_sec = secs % 60;
+  if (days != 0)
+  {
+    civilFromDays(daysFromCivil(t.tm_year + 1900LL, t.tm_mon + 1, t.tm_mday)
+                  + days, t);
+  }
+  cal.utc = utc;
+  return;
+} // end calendarAdvance
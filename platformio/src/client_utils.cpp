@@ -25,6 +25,12 @@
 #include "renderer.h"
 #include "icons/icons_196x196.h"
 #include <StreamUtils.h>
+#include "heap_tracker.h"
+#include "inflate_stream.h"
+#include "power_tier.h"
+#include "profiler.h"
+#include "telemetry.h"
+#include <StreamString.h>
 
 #if HTTP_MODE != HTTP
   #include <WiFiClientSecure.h>
@@ -44,12 +50,14 @@
  */
 wl_status_t startWiFi(int &wifiRSSI)
 {
+  PROFILE_SCOPE(PROF_WIFI);
   WiFi.mode(WIFI_STA);
   Serial.printf("%s '%s'", TXT_CONNECTING_TO, WIFI_SSID);
   WiFi.begin(WIFI_SSID, D_WIFI_PASSWORD);
 
-  // timeout if WiFi does not connect in WIFI_TIMEOUT ms from now
-  unsigned long timeout = millis() + WIFI_TIMEOUT;
+  // timeout if WiFi does not connect in WIFI_TIMEOUT ms from now, less when
+  // the battery is low
+  unsigned long timeout = millis() + wifiTimeout();
   wl_status_t connection_status = WiFi.status();
 
   while ((connection_status != WL_CONNECTED) && (millis() < timeout))
@@ -65,6 +73,7 @@ wl_status_t startWiFi(int &wifiRSSI)
     wifiRSSI = WiFi.RSSI(); // get WiFi signal strength now, because the WiFi
                             // will be turned off to save power!
     Serial.println("IP: " + WiFi.localIP().toString());
+    HEAP_CHECKPOINT(HEAP_WIFI);
   }
   else
   {
@@ -106,6 +115,7 @@ bool printLocalTime(tm *timeInfo)
  */
 bool waitForSNTPSync(tm *timeInfo)
 {
+  PROFILE_SCOPE(PROF_SNTP);
   // Wait for SNTP synchronization to complete
   unsigned long timeout = millis() + NTP_TIMEOUT;
   if ((sntp_get_sync_status() == SNTP_SYNC_STATUS_RESET) && (millis() < timeout))
@@ -150,6 +160,11 @@ bool makeAPICalls(owm_resp_onecall_t &resp_main, owm_resp_air_pollution_t &resp_
   }
 
 #ifdef POS_AIR_QUALITY
+  if (powerTier >= POWER_TIER_1)
+  { // skipped to save power, drawn as unknown
+    return true;
+  }
+
   // set start and end to appropriate values so that the last 24 hours of air
   // pollution history is returned. Unix, UTC.
   time_t now;
@@ -175,6 +190,88 @@ bool makeAPICalls(owm_resp_onecall_t &resp_main, owm_resp_air_pollution_t &resp_
   return true;
 }
 
+#if HTTP_COMPRESSION
+/* Sends a GET request for url to host over client, offering gzip and deflate,
+ * and reads the status line and headers of the response. Transfer-Encoding and
+ * Content-Encoding are returned through the references, the body is left to be
+ * read from client.
+ *
+ * HTTPClient (arduino-esp32 2.x) sends
+ *   Accept-Encoding: identity;q=1,chunked;q=0.1,*;q=0
+ * with every HTTP/1.1 request, and servers that read only the first
+ * Accept-Encoding ignore one added with addHeader(), so the request is written
+ * here instead.
+ *
+ * Returns the HTTP status code, or an HTTPClient error code.
+ */
+static int sendCompressedGet(WiFiClient &client, const String &host,
+                             const String &url, String &transferEncoding,
+                             String &contentEncoding)
+{
+  if (!client.connected()
+   && !client.connect(host.c_str(), PORT, httpTimeout()))
+  {
+    return HTTPC_ERROR_CONNECTION_REFUSED;
+  }
+  client.setTimeout((httpTimeout() + 500) / 1000); // seconds
+
+  String request = "GET " + url + " HTTP/1.1\r\n"
+                   "Host: " + host + "\r\n"
+                   "User-Agent: ESP32HTTPClient\r\n"
+                   "Connection: close\r\n"
+                   "Accept-Encoding: gzip, deflate\r\n"
+                   "\r\n";
+  if (client.print(request) != request.length())
+  {
+    return HTTPC_ERROR_SEND_HEADER_FAILED;
+  }
+
+  // ex. "HTTP/1.1 200 OK"
+  String line = client.readStringUntil('\n');
+  if (line.length() == 0)
+  {
+    return HTTPC_ERROR_READ_TIMEOUT;
+  }
+  int status = line.startsWith("HTTP/1.") ? line.substring(9, 12).toInt() : 0;
+  if (status <= 0)
+  {
+    return HTTPC_ERROR_NO_HTTP_SERVER;
+  }
+
+  // headers end with an empty line, every line ends with "\r\n"
+  while (true)
+  {
+    line = client.readStringUntil('\n');
+    if (line.length() == 0)
+    {
+      return HTTPC_ERROR_READ_TIMEOUT;
+    }
+    line.trim();
+    if (line.length() == 0)
+    {
+      break;
+    }
+    int colon = line.indexOf(':');
+    if (colon < 0)
+    {
+      continue;
+    }
+    String name = line.substring(0, colon);
+    String value = line.substring(colon + 1);
+    value.trim();
+    if (name.equalsIgnoreCase("Transfer-Encoding"))
+    {
+      transferEncoding = value;
+    }
+    else if (name.equalsIgnoreCase("Content-Encoding"))
+    {
+      contentEncoding = value;
+    }
+  }
+  return status;
+} // end sendCompressedGet
+#endif
+
 /* Perform an HTTP GET request to get the weather or air quality
  * If data is received, it will be parsed and stored in the global variable
  * owm_onecall or owm_air_pollution.
@@ -207,32 +304,102 @@ int getData(WiFiClient &client, String host, String url, T &r, DeserializationEr
       return -512 - static_cast<int>(connection_status);
     }
 
+#if PHASE_PROFILING
+    // Connect ahead of the request, which reuses the open connection, so that
+    // the lookup and the handshake are timed apart from it. lwIP
+    // caches the address, connect() does not resolve the host a second time.
+    IPAddress hostIP;
+    PROFILE_BEGIN(dnsScope, PROF_DNS);
+    WiFi.hostByName(host.c_str(), hostIP);
+    PROFILE_END(dnsScope);
+    PROFILE_BEGIN(connectScope, PROF_CONNECT);
+    client.connect(host.c_str(), PORT, httpTimeout());
+    PROFILE_END(connectScope);
+#endif
+    String transferEncoding;
+    String contentEncoding;
+#if HTTP_COMPRESSION
+    // the server may still answer uncompressed, Content-Encoding tells
+    PROFILE_BEGIN(firstByteScope, PROF_FIRST_BYTE);
+    httpResponse = sendCompressedGet(client, host, url, transferEncoding,
+                                     contentEncoding);
+    PROFILE_END(firstByteScope);
+#else
     HTTPClient http;
-    http.setConnectTimeout(HTTP_CLIENT_TCP_TIMEOUT); // default 5000ms
-    http.setTimeout(HTTP_CLIENT_TCP_TIMEOUT);        // default 5000ms
-    const char* keys[] = {"Transfer-Encoding"};
-    http.collectHeaders(keys, 1);
+    http.setConnectTimeout(httpTimeout()); // default 5000ms
+    http.setTimeout(httpTimeout());        // default 5000ms
+    const char* keys[] = {"Transfer-Encoding", "Content-Encoding"};
+    http.collectHeaders(keys, 2);
     http.begin(client, host, PORT, url);
+    PROFILE_BEGIN(firstByteScope, PROF_FIRST_BYTE);
     httpResponse = http.GET();
+    PROFILE_END(firstByteScope);
+    transferEncoding = http.header("Transfer-Encoding");
+    contentEncoding = http.header("Content-Encoding");
+#endif
+    HEAP_CHECKPOINT(HEAP_CONNECTED);
     if (httpResponse == HTTP_CODE_OK)
     {
-      Stream& rawStream = http.getStream();
+      // HTTPClient's stream is the client as well
+#if PHASE_PROFILING
+      ProfiledStream rawStream(client);
+#else
+      Stream& rawStream = client;
+#endif
       // Choose the right stream depending on the Transfer-Encoding header
       Stream* response = &rawStream;
-      if (http.header("Transfer-Encoding") == "chunked")
+      ChunkDecodingStream chunkedStream(rawStream);
+      if (transferEncoding == "chunked")
       {
-        response = new ChunkDecodingStream(rawStream);
+        response = &chunkedStream;
       }
-      jsonErr = deserializeCall(*response, r);
-      if (jsonErr)
+      // and stack the decompressor on top according to Content-Encoding
+      InflateStream inflateStream(*response,
+                                  contentEncoding == "gzip"
+                                  ? InflateStream::GZIP
+                                  : InflateStream::DEFLATE);
+      if (contentEncoding == "gzip" || contentEncoding == "deflate")
       {
-        // -256 offset distinguishes these errors from httpClient errors
-        httpResponse = -256 - static_cast<int>(jsonErr.code());
+#if DEBUG_LEVEL >= 1
+        Serial.println("[debug] Content-Encoding : " + contentEncoding);
+#endif
+        response = &inflateStream;
+        if (!inflateStream.begin())
+        {
+          httpResponse = HTTPC_ERROR_TOO_LESS_RAM;
+        }
+      }
+      if (httpResponse == HTTP_CODE_OK)
+      {
+        PROFILE_BEGIN(parseScope, PROF_JSON_PARSE);
+        jsonErr = deserializeCall(*response, r);
+        PROFILE_END(parseScope);
+#if TELEMETRY
+        telemetry.rx_bytes += rawStream.bytesRead();
+#endif
+#if DEBUG_LEVEL >= 1
+        if (inflateStream.failed())
+        {
+          Serial.println("[debug] Failed to inflate response");
+        }
+#endif
+        if (jsonErr)
+        {
+          // -256 offset distinguishes these errors from httpClient errors
+          httpResponse = -256 - static_cast<int>(jsonErr.code());
+        }
+        rxSuccess = !jsonErr;
       }
-      rxSuccess = !jsonErr;
     }
     client.stop();
+#if !HTTP_COMPRESSION
     http.end();
+#endif
+    HEAP_CHECKPOINT(HEAP_PARSED);
+#if TELEMETRY
+    telemetry.http_status = httpResponse;
+    telemetry.parse_error = jsonErr.code();
+#endif
     Serial.println("  " + String(httpResponse, DEC) + " " + getHttpResponsePhrase(httpResponse));
     ++attempts;
   }
@@ -240,6 +407,44 @@ int getData(WiFiClient &client, String host, String url, T &r, DeserializationEr
   return httpResponse;
 }
 
+#if TELEMETRY
+/* POSTs the telemetry records that have not been sent yet to D_TELEMETRY_URL
+ * as CSV. The record of this wake cycle is stored right before deep sleep, so
+ * it is sent during the next one.
+ */
+void uploadTelemetry()
+{
+  const char *url = D_TELEMETRY_URL;
+  if (url[0] == '\0' || WiFi.status() != WL_CONNECTED
+   || telemetryUploaded() >= telemetryCount())
+  {
+    return;
+  }
+
+  StreamString body;
+  const uint32_t count = telemetryCount();
+  printTelemetry(body, telemetryUploaded());
+
+  WiFiClient client;
+  HTTPClient http;
+  http.setConnectTimeout(httpTimeout());
+  http.setTimeout(httpTimeout());
+  http.begin(client, url);
+  http.addHeader("Content-Type", "text/csv");
+  int httpResponse = http.POST(body);
+  http.end();
+#if DEBUG_LEVEL >= 1
+  Serial.println("[debug] Telemetry upload : " + String(httpResponse, DEC)
+                 + " " + getHttpResponsePhrase(httpResponse));
+#endif
+  if (httpResponse >= 200 && httpResponse < 300)
+  {
+    setTelemetryUploaded(count);
+  }
+  return;
+} // end uploadTelemetry
+#endif
+
 /* Prints debug information about heap usage.
  */
 void printHeapUsage()
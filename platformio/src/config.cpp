@@ -75,6 +75,17 @@ const char *NTP_SERVER_2 = "time.nist.gov";
 // NTP_TIMEOUT or select closer/lower latency time servers.
 const unsigned long NTP_TIMEOUT = 20000; // ms
 
+// ADAPTIVE SLEEP
+// With adaptiveSleep the refresh interval stretches from sleepDuration up to
+// sleepDurationMax while the forecast for the coming hours is stable, and
+// shrinks to sleepDurationMin when a change is expected before the next
+// regular refresh. A change is a coming hour whose temperature differs from
+// that of the hour in progress by ADAPTIVE_SLEEP_TEMP_DELTA, whose probability
+// of precipitation reaches ADAPTIVE_SLEEP_POP or whose weather condition group
+// (ex. clear/clouds, rain, snow) differs from that of the hour in progress.
+const float ADAPTIVE_SLEEP_TEMP_DELTA = 2.0f; // (celsius)
+const int ADAPTIVE_SLEEP_POP = 30;            // (percent)
+
 // BATTERY
 // To protect the battery upon LOW_BATTERY_VOLTAGE, the display will cease to
 // update until battery is charged again. The ESP32 will deep-sleep (consuming
@@ -88,10 +99,49 @@ const uint32_t VERY_LOW_BATTERY_VOLTAGE = 3442;            // (millivolts)  ~8%
 const uint32_t CRIT_LOW_BATTERY_VOLTAGE = 3404;            // (millivolts)  ~5%
 const unsigned long LOW_BATTERY_SLEEP_INTERVAL = 30;       // (minutes)
 const unsigned long VERY_LOW_BATTERY_SLEEP_INTERVAL = 120; // (minutes)
+// A low battery state is only left once the voltage has risen
+// BATTERY_HYSTERESIS above the threshold it fell below, so that a voltage
+// hovering around LOW_BATTERY_VOLTAGE does not redraw the low battery screen
+// over and over.
+const uint32_t BATTERY_HYSTERESIS = 20;                    // (millivolts)
+// With powerTiers enabled, features are shed in steps as the battery drains
+// toward LOW_BATTERY_VOLTAGE. At or below POWER_TIER_1_VOLTAGE the air
+// pollution request is skipped and WiFi and HTTP give up after the shorter
+// POWER_TIER_*_TIMEOUTs, at POWER_TIER_2_VOLTAGE the hourly icons are dropped
+// and the sleep interval is doubled, and at POWER_TIER_3_VOLTAGE the indoor
+// readings are drawn with the full refresh and the sleep interval is
+// quadrupled.
+const uint32_t POWER_TIER_1_VOLTAGE = 3535;         // (millivolts) ~20%
+const uint32_t POWER_TIER_2_VOLTAGE = 3510;         // (millivolts) ~16%
+const uint32_t POWER_TIER_3_VOLTAGE = 3485;         // (millivolts) ~13%
+const unsigned long POWER_TIER_WIFI_TIMEOUT = 5000; // (milliseconds)
+const unsigned POWER_TIER_HTTP_TIMEOUT = 5000;      // (milliseconds)
+// With ulpBatteryMonitoring enabled, the ULP coprocessor samples the battery
+// every ULP_BATTERY_INTERVAL during deep sleep. While the battery is low, it
+// replaces the LOW_BATTERY_SLEEP_INTERVAL and VERY_LOW_BATTERY_SLEEP_INTERVAL
+// wake ups: the esp32 is only woken once the voltage rises above
+// LOW_BATTERY_VOLTAGE + BATTERY_HYSTERESIS or falls below
+// CRIT_LOW_BATTERY_VOLTAGE. Otherwise it wakes the esp32 early once the voltage
+// falls below LOW_BATTERY_VOLTAGE. The ULP averages fewer conversions than the
+// esp32 does, so each threshold is moved a further ULP_BATTERY_HYSTERESIS away
+// so that noise around it does not wake the esp32 over and over.
+const unsigned long ULP_BATTERY_INTERVAL = 60; // (seconds)
+const uint32_t ULP_BATTERY_HYSTERESIS = 20;    // (millivolts)
 // Battery voltage calculations are based on a typical 3.7v LiPo.
 const uint32_t MAX_BATTERY_VOLTAGE = 4200; // (millivolts)
 const uint32_t MIN_BATTERY_VOLTAGE = 3000; // (millivolts)
 
+// POWER MODEL
+// Used to estimate the charge drawn by each wake and the remaining battery
+// life. The currents are averages for the whole board (esp32, regulator and
+// e-paper driver board), measuring them on your own hardware will give the
+// best estimates.
+const uint32_t BATTERY_CAPACITY = 2000;  // (milliamp hours)
+const float CURRENT_RADIO = 110.0f;      // (milliamps) WiFi on, TX/RX
+const float CURRENT_CPU = 22.0f;         // (milliamps) CPU at 80MHz, WiFi off
+const float CURRENT_REFRESH = 32.0f;     // (milliamps) CPU and panel refresh
+const float CURRENT_DEEP_SLEEP = 0.014f; // (milliamps) deep sleep
+
 // See config.h for the below options
 // E-PAPER PANEL
 // LOCALE
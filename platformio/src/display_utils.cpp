@@ -17,54 +17,119 @@
 
 #include "display_utils.h"
       
+#include <algorithm>
 #include <esp_adc_cal.h>
 #include "icons/icons.h"
 #include "_strftime.h"
 #include "_locale.h"
+#include "alert_terms.h"
+#include "config.h"
+#include "power_tier.h"
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
 
-/* Returns battery voltage in millivolts (mv).
+// Number of ADC conversions per battery reading. The lowest and highest
+// quarter are discarded as outliers and the rest are averaged.
+#define BATTERY_ADC_SAMPLES 16
+
+// The ADC characterization only depends on the eFuse calibration bits, so it
+// is computed once and kept across deep sleep.
+RTC_DATA_ATTR static esp_adc_cal_characteristics_t batteryAdcChars;
+RTC_DATA_ATTR static bool batteryAdcCharsValid;
+
+/* Returns the battery voltage of a raw ADC1 reading of PIN_BAT_ADC, millivolts.
  */
-uint32_t readBatteryVoltage()
+uint32_t batteryAdcToVoltage(uint32_t adc_val)
 {
-  esp_adc_cal_characteristics_t adc_chars;
-  // __attribute__((unused)) disables compiler warnings about this variable
-  // being unused (Clang, GCC) which is the case when DEBUG_LEVEL == 0.
-  esp_adc_cal_value_t val_type __attribute__((unused));
-  adc_power_acquire();
-  uint16_t adc_val = analogRead(PIN_BAT_ADC);
-  adc_power_release();
-
-  // We will use the eFuse ADC calibration bits, to get accurate voltage
-  // readings. The DFRobot FireBeetle Esp32-E V1.0's ADC is 12 bit, and uses
-  // 11db attenuation, which gives it a measurable input voltage range of 150mV
-  // to 2450mV.
-  val_type = esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_11db,
-                                      ADC_WIDTH_BIT_12, 1100, &adc_chars);
+  if (!batteryAdcCharsValid)
+  {
+    // We will use the eFuse ADC calibration bits, to get accurate voltage
+    // readings. The DFRobot FireBeetle Esp32-E V1.0's ADC is 12 bit, and uses
+    // 11db attenuation, which gives it a measurable input voltage range of
+    // 150mV to 2450mV.
+    // __attribute__((unused)) disables compiler warnings about this variable
+    // being unused (Clang, GCC) which is the case when DEBUG_LEVEL == 0.
+    esp_adc_cal_value_t val_type __attribute__((unused));
+    val_type = esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_11db,
+                                        ADC_WIDTH_BIT_12, 1100,
+                                        &batteryAdcChars);
+    batteryAdcCharsValid = true;
 
 #if DEBUG_LEVEL >= 1
-  if (val_type == ESP_ADC_CAL_VAL_EFUSE_VREF)
-  {
-    Serial.println("[debug] ADC Cal eFuse Vref");
-  }
-  else if (val_type == ESP_ADC_CAL_VAL_EFUSE_TP)
-  {
-    Serial.println("[debug] ADC Cal Two Point");
-  }
-  else
-  {
-    Serial.println("[debug] ADC Cal Default");
-  }
+    if (val_type == ESP_ADC_CAL_VAL_EFUSE_VREF)
+    {
+      Serial.println("[debug] ADC Cal eFuse Vref");
+    }
+    else if (val_type == ESP_ADC_CAL_VAL_EFUSE_TP)
+    {
+      Serial.println("[debug] ADC Cal Two Point");
+    }
+    else
+    {
+      Serial.println("[debug] ADC Cal Default");
+    }
 #endif
+  }
 
-  uint32_t batteryVoltage = esp_adc_cal_raw_to_voltage(adc_val, &adc_chars);
+  uint32_t batteryVoltage = esp_adc_cal_raw_to_voltage(adc_val,
+                                                       &batteryAdcChars);
   // DFRobot FireBeetle Esp32-E V1.0 voltage divider (1M+1M), so readings are
   // multiplied by 2.
   batteryVoltage *= 2;
   return batteryVoltage;
+} // end batteryAdcToVoltage
+
+/* Returns battery voltage in millivolts (mv).
+ */
+uint32_t readBatteryVoltage()
+{
+  uint16_t adc_vals[BATTERY_ADC_SAMPLES];
+  adc_power_acquire();
+  for (int i = 0; i < BATTERY_ADC_SAMPLES; ++i)
+  {
+    adc_vals[i] = analogRead(PIN_BAT_ADC);
+  }
+  adc_power_release();
+
+  // mean of the middle half
+  std::sort(adc_vals, adc_vals + BATTERY_ADC_SAMPLES);
+  uint32_t sum = 0;
+  for (int i = BATTERY_ADC_SAMPLES / 4; i < BATTERY_ADC_SAMPLES * 3 / 4; ++i)
+  {
+    sum += adc_vals[i];
+  }
+  const uint32_t n = BATTERY_ADC_SAMPLES / 2;
+  return batteryAdcToVoltage((sum + n / 2) / n);
 } // end readBatteryVoltage
 
+/* Returns the battery state for a voltage, given the state of the previous
+ * wake. The state gets worse as soon as the voltage falls to a threshold, but
+ * only gets better once the voltage is BATTERY_HYSTERESIS above it, so that a
+ * voltage hovering around a threshold does not flip the state every wake.
+ */
+battery_state_t getBatteryState(uint32_t batVoltage, battery_state_t prev)
+{
+  const uint32_t thresholds[] = {
+    LOW_BATTERY_VOLTAGE,      // BATTERY_LOW
+    VERY_LOW_BATTERY_VOLTAGE, // BATTERY_VERY_LOW
+    CRIT_LOW_BATTERY_VOLTAGE  // BATTERY_CRIT_LOW
+  };
+  battery_state_t state = BATTERY_OK;
+  for (int s = BATTERY_LOW; s <= BATTERY_CRIT_LOW; ++s)
+  {
+    uint32_t threshold = thresholds[s - BATTERY_LOW];
+    if (s <= prev)
+    {
+      threshold += BATTERY_HYSTERESIS;
+    }
+    if (batVoltage <= threshold)
+    {
+      state = static_cast<battery_state_t>(s);
+    }
+  }
+  return state;
+} // end getBatteryState
+
 /* Returns battery percentage, rounded to the nearest integer.
  * Takes a voltage in millivolts and uses a sigmoidal approximation to find an
  * approximation of the battery life percentage remaining.
@@ -160,86 +225,138 @@ void getRefreshTimeStr(String &s, bool timeSuccess, tm *timeInfo)
   return;
 } // end getRefreshTimeStr
 
-/* Takes a String and capitalizes the first letter of every word.
+/* Takes a string and capitalizes the first letter of every word, in place.
  *
  * Ex:
  *   input   : "severe thunderstorm warning" or "SEVERE THUNDERSTORM WARNING"
  *   becomes : "Severe Thunderstorm Warning"
  */
-void toTitleCase(String &text)
+void toTitleCase(char *text)
 {
-  text.setCharAt(0, toUpperCase(text.charAt(0)));
+  if (text[0] == '\0')
+  {
+    return;
+  }
+  text[0] = toUpperCase(text[0]);
 
-  for (int i = 1; i < text.length(); ++i)
+  for (int i = 1; text[i] != '\0'; ++i)
   {
-    if (text.charAt(i - 1) == ' ' || text.charAt(i - 1) == '-' || text.charAt(i - 1) == '(')
+    if (text[i - 1] == ' ' || text[i - 1] == '-' || text[i - 1] == '(')
     {
-      text.setCharAt(i, toUpperCase(text.charAt(i)));
+      text[i] = toUpperCase(text[i]);
     }
     else
     {
-      text.setCharAt(i, toLowerCase(text.charAt(i)));
+      text[i] = toLowerCase(text[i]);
     }
   }
 
   return;
 } // end toTitleCase
 
-/* Takes a String and truncates at any of these characters ,.( and trims any
- * trailing whitespace.
+/* Takes a string and truncates it in place at any of these characters ,.( and
+ * trims any trailing whitespace.
  *
  * Ex:
  *   input   : "Severe Thunderstorm Warning, (Starting At 10 Pm)"
  *   becomes : "Severe Thunderstorm Warning"
+ *
+ * Returns the new length of the string.
  */
-void truncateExtraAlertInfo(String &text)
+size_t truncateExtraAlertInfo(char *text)
 {
-  if (text.isEmpty())
+  if (text[0] == '\0')
   {
-    return;
+    return 0;
   }
 
   int i = 1;
   int lastChar = i;
-  while (i < text.length() && text.charAt(i) != ',' && text.charAt(i) != '.' && text.charAt(i) != '(')
+  while (text[i] != '\0' && text[i] != ',' && text[i] != '.' && text[i] != '(')
   {
-    if (text.charAt(i) != ' ')
+    if (text[i] != ' ')
     {
       lastChar = i + 1;
     }
     ++i;
   }
 
-  text = text.substring(0, lastChar);
-  return;
+  text[lastChar] = '\0';
+  return lastChar;
 } // end truncateExtraAlertInfo
 
-/* Returns the urgency of an event based by checking if the event String
- * contains any indicator keywords.
+/* Finds the urgency and category of an alert with a single pass over its
+ * lowercase event text.
+ *
+ * The keywords of ALERT_URGENCY and the TERM_* lists in the included locale are
+ * compiled at build time into an Aho-Corasick automaton (alert_terms.h,
+ * generated by python/alert_terms.py). Every node carries the set of keywords
+ * that end there, so each character of the event is visited only once.
  *
- * Urgency keywords are defined in config.h because they are very regional.
+ * Urgency keywords are defined in the locale because they are very regional.
  *   ex: United States - (Watch < Advisory < Warning)
  *
- * The index in vector<String> ALERT_URGENCY indicates the urgency level.
- * If an event string matches none of these keywords the urgency is unknown, -1
- * is returned.
+ * The index in ALERT_URGENCY indicates the urgency level. If an event matches
+ * several keywords the most urgent one is used, and if it matches none of them
+ * the urgency is unknown, -1.
  * In the United States example, Watch = 0, Advisory = 1, Warning = 2
+ *
+ * The category is the first alert_category with a matching term, or NOT_FOUND.
+ * Only the text that remains after truncateExtraAlertInfo is considered, since
+ * that is the event name the icon is drawn next to.
+ *
+ * Note: Matching is case sensitive.
  */
-int eventUrgency(const String &event)
+void classifyAlert(const char *event, int8_t &urgency, int8_t &category)
 {
-  int urgency_lvl = -1;
-  for (int i = 0; i < ALERT_URGENCY.size(); ++i)
+  uint32_t categories = ALERT_TERMS_CATEGORY[0];
+  uint32_t urgencies = ALERT_TERMS_URGENCY[0];
+  bool truncated = false;
+  uint16_t node = 0;
+
+  for (size_t i = 0; event[i] != '\0'; ++i)
   {
-    if (event.indexOf(ALERT_URGENCY[i]) >= 0)
+    const uint8_t c = event[i];
+    if (i > 0 && (c == ',' || c == '.' || c == '('))
     {
-      urgency_lvl = i;
+      truncated = true;
+    }
+
+    // follow fail links until a node with an edge for c is found
+    while (true)
+    {
+      uint16_t e = ALERT_TERMS_EDGE_START[node];
+      const uint16_t end = ALERT_TERMS_EDGE_START[node + 1];
+      while (e < end && ALERT_TERMS_EDGE_CHAR[e] < c)
+      {
+        ++e;
+      }
+      if (e < end && ALERT_TERMS_EDGE_CHAR[e] == c)
+      {
+        node = ALERT_TERMS_EDGE_NEXT[e];
+        break;
+      }
+      if (node == 0)
+      {
+        break;
+      }
+      node = ALERT_TERMS_FAIL[node];
+    }
+
+    urgencies |= ALERT_TERMS_URGENCY[node];
+    if (!truncated)
+    {
+      categories |= ALERT_TERMS_CATEGORY[node];
     }
   }
-  return urgency_lvl;
-} // end eventUrgency
+
+  urgency = urgencies ? 31 - __builtin_clz(urgencies) : -1;
+  category = categories ? __builtin_ctz(categories) : NOT_FOUND;
+  return;
+} // end classifyAlert
 
 /* This algorithm filters alerts from the API responses to be displayed by
- * marking the corresponding index in the ignore list.
+ * setting the corresponding bit in the ignore list.
  *
  * Background:
  * The display layout is setup to show up to 2 alerts, but alerts can be
@@ -249,8 +366,8 @@ int eventUrgency(const String &event)
  * Depending on the region different keywords are used to convey the level of
  * urgency.
  *
- * A vector array is used to store these keywords. (defined in config.h) Urgency
- * is ranked from low to high where the first index of the vector is the least
+ * An array is used to store these keywords. (defined in the locale) Urgency
+ * is ranked from low to high where the first index of the array is the least
  * urgent keyword and the last index is the most urgent keyword. Expected as all
  * lowercase.
  *
@@ -271,37 +388,51 @@ int eventUrgency(const String &event)
  *
  * Truncate Extraneous Info (anything that follows a comma, period, or open
  *   parentheses)
+ *
+ * All text is edited in place in the alert pool.
  */
-void filterAlerts(std::vector<owm_alerts_t> &resp, int *ignore_list)
+void filterAlerts(owm_resp_alerts_t &alerts, uint32_t &ignore_list)
 {
+  static_assert(OWM_NUM_ALERTS <= 32, "ignore_list is a 32 bit bitmap");
+
   // Convert all event text and tags to lowercase.
-  for (auto &alert : resp)
+  for (uint16_t i = 0; i < alerts.pool_used; ++i)
   {
-    alert.event.toLowerCase();
-    alert.tags.toLowerCase();
+    alerts.pool[i] = toLowerCase(alerts.pool[i]);
+  }
+
+  // Determine the urgency and category of each alert once.
+  for (int i = 0; i < alerts.num; ++i)
+  {
+    owm_alerts_t &alert = alerts.list[i];
+    classifyAlert(&alerts.pool[alert.event.offset],
+                  alert.urgency, alert.category);
   }
 
   // Deduplicate alerts with the same first tag. Keeping only the most urgent
   // alerts of each tag and alerts who's urgency cannot be determined.
-  for (int i = 0; i < resp.size(); ++i)
+  for (int i = 0; i < alerts.num; ++i)
   {
-    if (ignore_list[i] == 1)
+    if (ignore_list & (1UL << i))
     {
       continue;
     }
-    if (resp[i].tags.isEmpty())
+    const owm_alerts_t &alert_i = alerts.list[i];
+    if (alert_i.tags.length == 0)
     {
       continue; // urgency can not be determined so it remains in the list
     }
 
-    for (int j = 0; j < resp.size(); ++j)
+    for (int j = 0; j < alerts.num; ++j)
     {
-      if (i != j && resp[i].tags == resp[j].tags)
+      const owm_alerts_t &alert_j = alerts.list[j];
+      if (i != j && strcmp(&alerts.pool[alert_i.tags.offset],
+                           &alerts.pool[alert_j.tags.offset]) == 0)
       {
         // comparing alerts of the same tag, removing the less urgent alert
-        if (eventUrgency(resp[i].event) >= eventUrgency(resp[j].event))
+        if (alert_i.urgency >= alert_j.urgency)
         {
-          ignore_list[j] = 1;
+          ignore_list |= 1UL << j;
         }
       }
     }
@@ -309,22 +440,23 @@ void filterAlerts(std::vector<owm_alerts_t> &resp, int *ignore_list)
 
   // Save only the 2 most recent alerts
   int valid_cnt = 0;
-  for (int i = 0; i < resp.size(); ++i)
+  for (int i = 0; i < alerts.num; ++i)
   {
-    if (valid_cnt < 2 && !ignore_list[i])
+    if (valid_cnt < 2 && !(ignore_list & (1UL << i)))
     {
       ++valid_cnt;
     }
     else
     {
-      ignore_list[i] = 1;
+      ignore_list |= 1UL << i;
     }
   }
 
   // Remove trailing/extraneous information
-  for (auto &alert : resp)
+  for (int i = 0; i < alerts.num; ++i)
   {
-    truncateExtraAlertInfo(alert.event);
+    owm_span_t &event = alerts.list[i].event;
+    event.length = truncateExtraAlertInfo(&alerts.pool[event.offset]);
   }
 
   return;
@@ -356,6 +488,38 @@ const char *getUVIdesc(unsigned int uvi)
   }
 } // end getUVIdesc
 
+/* Calculates the air quality index of the locale's AQI_SCALE from the
+ * pollutant history in p.components, and stores it in p along with its
+ * descriptor and label. This is done once after the API calls so that paged
+ * displays don't re-evaluate the index for every page drawn.
+ */
+void calcAirQuality(owm_resp_air_pollution_t &p)
+{
+  const owm_components_t &c = p.components;
+  if (powerTier >= POWER_TIER_1)
+  { // the request was skipped to save power, aqi < 0 is drawn as unknown
+    p.aqi = -1;
+    p.aqi_desc = "";
+  }
+  else
+  {
+    // OpenWeatherMap does not provide pb (lead) conentrations, so we pass
+    // NULL.
+    p.aqi = calc_aqi(AQI_SCALE, c.co, c.nh3, c.no, c.no2, c.o3, NULL, c.so2,
+                                c.pm10, c.pm2_5);
+    p.aqi_desc = aqi_desc(AQI_SCALE, p.aqi);
+  }
+  if (aqi_desc_type(AQI_SCALE) == AIR_QUALITY_DESC)
+  {
+    p.aqi_label = TXT_AIR_QUALITY;
+  }
+  else // (aqi_desc_type(AQI_SCALE) == AIR_POLLUTION_DESC)
+  {
+    p.aqi_label = TXT_AIR_POLLUTION;
+  }
+  return;
+} // end calcAirQuality
+
 /* Returns the wifi signal strength descriptor text for the given RSSI.
  */
 const char *getWiFidesc(int rssi)
@@ -966,6 +1130,65 @@ const uint8_t *getConditionsBitmap(int id, bool day, bool moon, bool cloudy,
 } // end getConditionsBitmap
 #endif
 
+/* Takes a weather condition id (from the API response) and returns its group,
+ * the same for every weather API: 2 thunderstorm, 3 drizzle, 5 rain, 6 snow,
+ * 7 atmosphere (fog, haze, ...), 8 clear or clouds, 0 if unknown.
+ *
+ * References:
+ *   https://openweathermap.org/weather-conditions
+ *   https://open-meteo.com/en/docs (WMO Weather interpretation codes)
+ */
+int getConditionGroup(int id)
+{
+#if WEATHER_API == OPEN_WEATHER_MAP
+  if (id >= 200 && id < 900)
+  {
+    return id / 100;
+  }
+  return 0;
+#elif WEATHER_API == OPEN_METEO
+  switch (id)
+  {
+  case 0: // Clear sky
+  case 1: // Mainly clear
+  case 2: // Partly cloudy
+  case 3: // Overcast
+    return 8;
+  case 45: // Fog
+  case 48: // Depositing rime fog
+    return 7;
+  case 51: // Light drizzle
+  case 53: // Moderate drizzle
+  case 55: // Dense drizzle
+  case 56: // Light freezing drizzle
+  case 57: // Dense freezing drizzle
+    return 3;
+  case 61: // Slight rain
+  case 63: // Moderate rain
+  case 65: // Heavy rain
+  case 66: // Light freezing rain
+  case 67: // Heavy freezing rain
+  case 80: // Slight rain showers
+  case 81: // Moderate rain showers
+  case 82: // Violent rain showers
+    return 5;
+  case 71: // Slight snow fall
+  case 73: // Moderate snow fall
+  case 75: // Heavy snow fall
+  case 77: // Snow grains
+  case 85: // Slight snow showers
+  case 86: // Heavy snow showers
+    return 6;
+  case 95: // Thunderstorm
+  case 96: // Thunderstorm with slight hail
+  case 99: // Thunderstorm with heavy hail
+    return 2;
+  default:
+    return 0;
+  }
+#endif
+} // end getConditionGroup
+
 /* Takes the daily weather forecast (from OpenWeatherMap API response) and
  * returns a pointer to the icon's 32x32 bitmap.
  *
@@ -1017,15 +1240,13 @@ const uint8_t *getCurrentConditionsBitmap196(const owm_current_t &current,
 
 /* Returns a 32x32 bitmap for a given alert.
  *
- * The purpose of this function is to return a relevant bitmap for an alert.
- * This is done by searching the event text for key terminology defined in the
- * included locale header.
- * If a relevant category can not be determined, the default alert bitmap will
+ * The purpose of this function is to return a relevant bitmap for an alert
+ * category, as found by classifyAlert.
+ * If a relevant category could not be determined, the default alert bitmap will
  * be returned. (warning triangle icon)
  */
-const uint8_t *getAlertBitmap32(const owm_alerts_t &alert)
+const uint8_t *getAlertBitmap32(enum alert_category c)
 {
-  enum alert_category c = getAlertCategory(alert);
   switch (c)
   {
   // this is the default if an alert wasn't associated with a catagory
@@ -1089,15 +1310,13 @@ const uint8_t *getAlertBitmap32(const owm_alerts_t &alert)
 
 /* Returns a 48x48 bitmap for a given alert.
  *
- * The purpose of this function is to return a relevant bitmap for an alert.
- * This is done by searching the event text for key terminology defined in the
- * included locale header.
- * If a relevant category can not be determined, the default alert bitmap will
+ * The purpose of this function is to return a relevant bitmap for an alert
+ * category, as found by classifyAlert.
+ * If a relevant category could not be determined, the default alert bitmap will
  * be returned. (warning triangle icon)
  */
-const uint8_t *getAlertBitmap48(const owm_alerts_t &alert)
+const uint8_t *getAlertBitmap48(enum alert_category c)
 {
-  enum alert_category c = getAlertCategory(alert);
   switch (c)
   {
   // this is the default if an alert wasn't associated with a catagory
@@ -1159,128 +1378,6 @@ const uint8_t *getAlertBitmap48(const owm_alerts_t &alert)
   }
 } // end getAlertBitmap48
 
-/* Returns true of a String, s, contains any of the strings in the terminology
- * vector.
- *
- * Note: This function is case sensitive.
- */
-bool containsTerminology(const String s, const std::vector<String> &terminology)
-{
-  for (const String &term : terminology)
-  {
-    if (s.indexOf(term) >= 0)
-    {
-      return true;
-    }
-  }
-  return false;
-} // end containsTerminology
-
-/* Returns the category of an alert based on the terminology found in the event
- * name.
- *
- * Weather alert terminology is defined in the included locale header.
- */
-enum alert_category getAlertCategory(const owm_alerts_t &alert)
-{
-  if (containsTerminology(alert.event, TERM_SMOG))
-  {
-    return alert_category::SMOG;
-  }
-  if (containsTerminology(alert.event, TERM_SMOKE))
-  {
-    return alert_category::SMOKE;
-  }
-  if (containsTerminology(alert.event, TERM_FOG))
-  {
-    return alert_category::FOG;
-  }
-  if (containsTerminology(alert.event, TERM_METEOR))
-  {
-    return alert_category::METEOR;
-  }
-  if (containsTerminology(alert.event, TERM_NUCLEAR))
-  {
-    return alert_category::NUCLEAR;
-  }
-  if (containsTerminology(alert.event, TERM_BIOHAZARD))
-  {
-    return alert_category::BIOHAZARD;
-  }
-  if (containsTerminology(alert.event, TERM_EARTHQUAKE))
-  {
-    return alert_category::EARTHQUAKE;
-  }
-  if (containsTerminology(alert.event, TERM_FIRE))
-  {
-    return alert_category::FIRE;
-  }
-  if (containsTerminology(alert.event, TERM_HEAT))
-  {
-    return alert_category::HEAT;
-  }
-  if (containsTerminology(alert.event, TERM_WINTER))
-  {
-    return alert_category::WINTER;
-  }
-  if (containsTerminology(alert.event, TERM_TSUNAMI))
-  {
-    return alert_category::TSUNAMI;
-  }
-  if (containsTerminology(alert.event, TERM_LIGHTNING))
-  {
-    return alert_category::LIGHTNING;
-  }
-  if (containsTerminology(alert.event, TERM_SANDSTORM))
-  {
-    return alert_category::SANDSTORM;
-  }
-  if (containsTerminology(alert.event, TERM_FLOOD))
-  {
-    return alert_category::FLOOD;
-  }
-  if (containsTerminology(alert.event, TERM_VOLCANO))
-  {
-    return alert_category::VOLCANO;
-  }
-  if (containsTerminology(alert.event, TERM_AIR_QUALITY))
-  {
-    return alert_category::AIR_QUALITY;
-  }
-  if (containsTerminology(alert.event, TERM_TORNADO))
-  {
-    return alert_category::TORNADO;
-  }
-  if (containsTerminology(alert.event, TERM_SMALL_CRAFT_ADVISORY))
-  {
-    return alert_category::SMALL_CRAFT_ADVISORY;
-  }
-  if (containsTerminology(alert.event, TERM_GALE_WARNING))
-  {
-    return alert_category::GALE_WARNING;
-  }
-  if (containsTerminology(alert.event, TERM_STORM_WARNING))
-  {
-    return alert_category::STORM_WARNING;
-  }
-  if (containsTerminology(alert.event, TERM_HURRICANE_WARNING))
-  {
-    return alert_category::HURRICANE_WARNING;
-  }
-  if (containsTerminology(alert.event, TERM_HURRICANE))
-  {
-    return alert_category::HURRICANE;
-  }
-  if (containsTerminology(alert.event, TERM_DUST))
-  {
-    return alert_category::DUST;
-  }
-  if (containsTerminology(alert.event, TERM_STRONG_WIND))
-  {
-    return alert_category::STRONG_WIND;
-  }
-  return alert_category::NOT_FOUND;
-} // end getAlertCategory
 
 #if WIND_ARROW_PRECISION == CARDINAL
 static const unsigned char *wind_direction_icon_arr[] = {
@@ -0,0 +1,263 @@
+/* Energy estimation for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "energy.h"
+
+#if ENERGY_ESTIMATION
+
+#include <algorithm>
+#include <cmath>
+#include <time.h>
+#include <Arduino.h>
+#include "display_utils.h"
+
+#define US_PER_HOUR 3600000000.0
+#define SECONDS_PER_DAY 86400
+// Battery voltage is sampled at most this often, so that the few samples kept
+// span a few days.
+#define BATTERY_SAMPLES 8
+#define BATTERY_SAMPLE_INTERVAL (6 * 3600) // seconds
+// A rise larger than this means the battery was charged and the trend starts
+// over.
+#define BATTERY_CHARGE_RISE 100 // millivolts
+
+typedef struct battery_sample
+{
+  int64_t time;
+  uint32_t voltage;
+} battery_sample_t;
+
+RTC_DATA_ATTR static battery_sample_t batterySamples[BATTERY_SAMPLES];
+RTC_DATA_ATTR static uint32_t batterySampleCount;
+RTC_DATA_ATTR static uint32_t lastBatteryVoltage;
+
+/* Returns the current drawn during a phase, milliamps. The radio stays on
+ * from WiFi association until the last response has been parsed.
+ */
+static float phaseCurrent(int phase)
+{
+  switch (phase)
+  {
+  case PROF_WIFI:
+  case PROF_SNTP:
+  case PROF_DNS:
+  case PROF_CONNECT:
+  case PROF_FIRST_BYTE:
+  case PROF_BODY_READ:
+  case PROF_JSON_PARSE:
+    return CURRENT_RADIO;
+  case PROF_REFRESH:
+  case PROF_BUSY:
+    return CURRENT_REFRESH;
+  default:
+    return CURRENT_CPU;
+  }
+} // end phaseCurrent
+
+/* Returns the charge drawn while awake during a wake cycle, milliamp hours.
+ * Time not attributed to any phase is charged at CURRENT_CPU.
+ */
+float wakeCharge(const profile_cycle_t &cycle)
+{
+  double charge = 0; // milliamp microseconds
+  uint32_t attributed = 0;
+  for (int p = 0; p < PROF_NUM_PHASES; ++p)
+  {
+    charge += (double) cycle.phase_us[p] * phaseCurrent(p);
+    attributed += cycle.phase_us[p];
+  }
+  charge += (double) (cycle.awake_us - attributed) * CURRENT_CPU;
+  return charge / US_PER_HOUR;
+} // end wakeCharge
+
+/* Returns the average charge drawn per wake over the profile history,
+ * milliamp hours, or NAN if no cycle has been profiled yet.
+ */
+float averageWakeCharge()
+{
+  const profile_cycle_t *history;
+  const uint32_t n = getProfileHistory(history);
+  if (n == 0)
+  {
+    return NAN;
+  }
+  float sum = 0;
+  for (uint32_t i = 0; i < n; ++i)
+  {
+    sum += wakeCharge(history[i]);
+  }
+  return sum / n;
+} // end averageWakeCharge
+
+/* Returns the number of wakes per day from WAKE_TIME until BED_TIME, at the
+ * average of the refresh intervals recorded in the profile history. These are
+ * the intervals actually used, stretched by adaptive sleep and the power tiers.
+ * SLEEP_DURATION until a cycle has been profiled.
+ */
+float wakesPerDay()
+{
+  const int awakeHours = BED_TIME == WAKE_TIME
+                         ? 24
+                         : (BED_TIME - WAKE_TIME + 24) % 24;
+  const profile_cycle_t *history;
+  const uint32_t n = getProfileHistory(history);
+  float interval = SLEEP_DURATION;
+  if (n > 0)
+  {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      sum += history[i].sleep_min;
+    }
+    interval = std::max((float) sum / n, 1.0f);
+  }
+  return std::ceil(awakeHours * 60.0f / interval);
+} // end wakesPerDay
+
+/* Returns the charge drawn per day, milliamp hours. The time spent awake is
+ * small enough that the whole day is charged at the deep sleep current too.
+ */
+float dailyCharge()
+{
+  return wakesPerDay() * averageWakeCharge() + 24 * CURRENT_DEEP_SLEEP;
+} // end dailyCharge
+
+/* Records a battery voltage reading for the discharge trend. Readings are only
+ * kept once the time has been synchronized.
+ */
+void recordBatteryVoltage(uint32_t batVoltage)
+{
+  lastBatteryVoltage = batVoltage;
+  time_t now = time(nullptr);
+  if (now < 1577836800) // 2020-01-01, the time was never set
+  {
+    return;
+  }
+
+  if (batterySampleCount > 0)
+  {
+    const battery_sample_t &last =
+      batterySamples[(batterySampleCount - 1) % BATTERY_SAMPLES];
+    if (batVoltage > last.voltage + BATTERY_CHARGE_RISE)
+    {
+      batterySampleCount = 0;
+    }
+    else if (now - last.time < BATTERY_SAMPLE_INTERVAL)
+    {
+      return;
+    }
+  }
+  battery_sample_t &sample =
+    batterySamples[batterySampleCount % BATTERY_SAMPLES];
+  sample.time = now;
+  sample.voltage = batVoltage;
+  ++batterySampleCount;
+  return;
+} // end recordBatteryVoltage
+
+/* Returns the percentage of the battery that can still be used before the
+ * CRIT_LOW_BATTERY_VOLTAGE cut-off.
+ */
+static float usablePercent(uint32_t batVoltage)
+{
+  const float p = (float) calcBatPercent(batVoltage, MIN_BATTERY_VOLTAGE,
+                                         MAX_BATTERY_VOLTAGE)
+                - (float) calcBatPercent(CRIT_LOW_BATTERY_VOLTAGE,
+                                         MIN_BATTERY_VOLTAGE,
+                                         MAX_BATTERY_VOLTAGE);
+  return p > 0 ? p : 0;
+} // end usablePercent
+
+/* Returns the days of battery life left according to the power model, or NAN
+ * if no cycle has been profiled yet.
+ */
+float batteryDaysModel(uint32_t batVoltage)
+{
+  return BATTERY_CAPACITY * usablePercent(batVoltage) / 100.0f
+         / dailyCharge();
+} // end batteryDaysModel
+
+/* Returns the days of battery life left according to the trend of the
+ * recorded voltages, or NAN until they span a day. The voltages are converted
+ * to percentages so that the flat middle of the discharge curve does not skew
+ * the fit.
+ */
+float batteryDaysTrend()
+{
+  const uint32_t n = batterySampleCount < BATTERY_SAMPLES
+                     ? batterySampleCount : BATTERY_SAMPLES;
+  if (n < 3)
+  {
+    return NAN;
+  }
+
+  // least squares fit of percent over days, relative to the latest sample
+  const battery_sample_t &latest =
+    batterySamples[(batterySampleCount - 1) % BATTERY_SAMPLES];
+  double sx = 0, sy = 0, sxx = 0, sxy = 0, span = 0;
+  for (uint32_t i = 0; i < n; ++i)
+  {
+    const double x = (double) (batterySamples[i].time - latest.time)
+                     / SECONDS_PER_DAY;
+    const double y = usablePercent(batterySamples[i].voltage);
+    sx += x;
+    sy += y;
+    sxx += x * x;
+    sxy += x * y;
+    span = std::min(span, x);
+  }
+  const double den = n * sxx - sx * sx;
+  if (span > -1.0 || den <= 0)
+  {
+    return NAN;
+  }
+  const double slope = (n * sxy - sx * sy) / den; // percent per day
+  if (slope >= 0)
+  {
+    return NAN; // not discharging, ex. solar charged
+  }
+  return usablePercent(latest.voltage) / -slope;
+} // end batteryDaysTrend
+
+/* Returns the days of battery life left, from the voltage trend once there is
+ * enough history, otherwise from the power model. NAN if neither is known yet.
+ */
+float estimateBatteryDays(uint32_t batVoltage)
+{
+  float days = batteryDaysTrend();
+  return std::isnan(days) ? batteryDaysModel(batVoltage) : days;
+} // end estimateBatteryDays
+
+/* Prints the energy estimates, cycle is this wake cycle as returned by
+ * finishProfile().
+ */
+void printEnergyEstimate(const profile_cycle_t &cycle)
+{
+#if DEBUG_LEVEL >= 1
+  Serial.printf("[debug] Charge this wake : %.3f mAh\n", wakeCharge(cycle));
+  Serial.printf("[debug] Charge per wake  : %.3f mAh\n", averageWakeCharge());
+  Serial.printf("[debug] Charge per day   : %.1f mAh (%.0f wakes)\n",
+                dailyCharge(), wakesPerDay());
+  Serial.printf("[debug] Battery life     : %.0f days (model) %.0f days "
+                "(trend)\n", batteryDaysModel(lastBatteryVoltage),
+                batteryDaysTrend());
+  Serial.flush();
+#endif
+  return;
+} // end printEnergyEstimate
+
+#endif
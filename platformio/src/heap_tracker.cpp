@@ -0,0 +1,124 @@
+/* Heap tracker for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "heap_tracker.h"
+
+#if HEAP_TRACKING
+
+#include <Arduino.h>
+
+// Each API request passes CONNECTED, JSON_DOC and PARSED, so some points are
+// sampled more than once per cycle. The last sample is kept for HEAP_SLEEP.
+#define HEAP_MAX_SAMPLES 16
+
+static const char *const HEAP_POINT_NAMES[HEAP_NUM_POINTS] =
+{
+  "boot",
+  "wifi",
+  "connected",
+  "json doc",
+  "parsed",
+  "wifi off",
+  "alerts",
+  "render",
+  "sleep",
+};
+
+typedef struct heap_sample
+{
+  uint8_t point;
+  uint32_t free;
+  uint32_t min_free;
+  uint32_t max_alloc; // largest free block
+} heap_sample_t;
+
+static heap_sample_t heapSamples[HEAP_MAX_SAMPLES];
+static uint8_t heapSampleCount;
+static uint8_t heapSamplesDropped;
+
+// The smallest largest free block seen since power-on, and where it was seen.
+// Survives deep sleep so sporadic out of memory errors can be traced back.
+RTC_DATA_ATTR static uint32_t worstMaxAlloc;
+RTC_DATA_ATTR static uint8_t worstPoint;
+
+/* Samples the heap at a point of the wake cycle.
+ */
+void heapCheckpoint(heap_point_t point)
+{
+  if (heapSampleCount >= HEAP_MAX_SAMPLES
+   || (heapSampleCount == HEAP_MAX_SAMPLES - 1 && point != HEAP_SLEEP))
+  {
+    ++heapSamplesDropped;
+    return;
+  }
+  heap_sample_t &s = heapSamples[heapSampleCount++];
+  s.point = point;
+  s.free = ESP.getFreeHeap();
+  s.min_free = ESP.getMinFreeHeap();
+  s.max_alloc = ESP.getMaxAllocHeap();
+
+  if (worstMaxAlloc == 0 || s.max_alloc < worstMaxAlloc)
+  {
+    worstMaxAlloc = s.max_alloc;
+    worstPoint = point;
+  }
+  return;
+} // end heapCheckpoint
+
+/* Prints the samples of this cycle with the change in the largest free block
+ * since the previous sample, and the phase with the largest drop.
+ */
+void printHeapCheckpoints()
+{
+#if DEBUG_LEVEL >= 1
+  Serial.printf("[debug] %-10s %7s %7s %7s %7s\n",
+                "heap at", "free", "min", "block", "change");
+  int worstDrop = 0;
+  int worstIndex = -1;
+  for (int i = 0; i < heapSampleCount; ++i)
+  {
+    const heap_sample_t &s = heapSamples[i];
+    int change = i > 0 ? (int) s.max_alloc - (int) heapSamples[i - 1].max_alloc
+                       : 0;
+    if (change < worstDrop)
+    {
+      worstDrop = change;
+      worstIndex = i;
+    }
+    Serial.printf("[debug] %-10s %7u %7u %7u %+7d\n",
+                  HEAP_POINT_NAMES[s.point], (unsigned) s.free,
+                  (unsigned) s.min_free, (unsigned) s.max_alloc, change);
+  }
+  if (heapSamplesDropped > 0)
+  {
+    Serial.printf("[debug] %u samples dropped, increase HEAP_MAX_SAMPLES\n",
+                  (unsigned) heapSamplesDropped);
+  }
+  if (worstIndex > 0)
+  {
+    Serial.printf("[debug] Largest block drop %d B, %s -> %s\n", worstDrop,
+                  HEAP_POINT_NAMES[heapSamples[worstIndex - 1].point],
+                  HEAP_POINT_NAMES[heapSamples[worstIndex].point]);
+  }
+  Serial.printf("[debug] Smallest block since power-on %u B, at %s\n",
+                (unsigned) worstMaxAlloc, HEAP_POINT_NAMES[worstPoint]);
+  Serial.flush();
+#endif
+  return;
+} // end printHeapCheckpoints
+
+#endif
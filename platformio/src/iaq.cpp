@@ -0,0 +1,119 @@
+/* Indoor air quality for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "iaq.h"
+
+#ifdef POS_IN_IAQ
+
+#include <algorithm>
+#include <cmath>
+
+// The humidity considered ideal, percent.
+#define IAQ_HUMIDITY_BASELINE 40.f
+// The share of the index given to humidity, the rest is given to gas.
+#define IAQ_HUMIDITY_WEIGHT 0.25f
+// The baseline moves this fraction of the way to a higher gas resistance...
+#define IAQ_BASELINE_RISE 0.25f
+// ...and decays by this fraction each wake, to follow the drift of the sensor.
+#define IAQ_BASELINE_DECAY 0.001f
+// The baseline is written to NVS once it has moved this fraction, to spare
+// the flash a write every wake.
+#define IAQ_BASELINE_SAVE 0.02f
+
+// Gas resistance of clean air, ohms. 0 until known.
+RTC_DATA_ATTR static float gasBaseline;
+// The baseline as last stored in NVS, ohms.
+RTC_DATA_ATTR static float gasBaselineSaved;
+
+/* Loads the gas baseline from NVS after a reset or power loss, until then the
+ * copy in RTC memory is used.
+ */
+void loadGasBaseline(Preferences &prefs)
+{
+  if (gasBaseline <= 0)
+  {
+    gasBaseline = prefs.getFloat("gasBase", 0);
+    gasBaselineSaved = gasBaseline;
+  }
+  return;
+} // end loadGasBaseline
+
+/* Returns true if the baseline has moved enough since it was stored in NVS to
+ * be stored again.
+ */
+bool gasBaselineStale()
+{
+  return gasBaseline > 0
+         && std::fabs(gasBaseline - gasBaselineSaved)
+            > gasBaselineSaved * IAQ_BASELINE_SAVE;
+} // end gasBaselineStale
+
+/* Stores the baseline in NVS, so that it survives a power loss and the index
+ * does not have to settle again.
+ */
+void saveGasBaseline(Preferences &prefs)
+{
+  prefs.putFloat("gasBase", gasBaseline);
+  gasBaselineSaved = gasBaseline;
+  return;
+} // end saveGasBaseline
+
+/* Returns the indoor air quality index, 0 (clean) to 500 (heavily polluted),
+ * or -1 if unknown, and updates the baseline.
+ *
+ * Volatile organic compounds lower the resistance of the heated gas sensor, so
+ * the resistance is compared to that of the cleanest air seen recently.
+ * Humidity also lowers the resistance and is uncomfortable at either end, so
+ * it is scored by its distance from IAQ_HUMIDITY_BASELINE. Bosch's BSEC
+ * library computes the index from the same inputs, but is closed source.
+ */
+int calcIaq(float gasResistance, float humidity)
+{
+  if (std::isnan(gasResistance) || gasResistance <= 0 || std::isnan(humidity))
+  {
+    return -1;
+  }
+
+  if (gasBaseline <= 0)
+  {
+    gasBaseline = gasResistance;
+  }
+  else if (gasResistance > gasBaseline)
+  {
+    gasBaseline += (gasResistance - gasBaseline) * IAQ_BASELINE_RISE;
+  }
+  else
+  {
+    gasBaseline -= gasBaseline * IAQ_BASELINE_DECAY;
+  }
+
+  float humidityScore; // 1 is ideal
+  if (humidity >= IAQ_HUMIDITY_BASELINE)
+  {
+    humidityScore = (100 - humidity) / (100 - IAQ_HUMIDITY_BASELINE);
+  }
+  else
+  {
+    humidityScore = humidity / IAQ_HUMIDITY_BASELINE;
+  }
+  const float gasScore = std::min(gasResistance / gasBaseline, 1.f);
+  const float quality = IAQ_HUMIDITY_WEIGHT * std::max(humidityScore, 0.f)
+                      + (1 - IAQ_HUMIDITY_WEIGHT) * gasScore;
+  return static_cast<int>(std::round((1 - quality) * 500));
+} // end calcIaq
+
+#endif
@@ -0,0 +1,129 @@
+/* Indoor history for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "indoor_history.h"
+
+#if INDOOR_HISTORY
+
+#include <algorithm>
+#include <cmath>
+#include <Arduino.h>
+
+// The last INDOOR_HISTORY_READINGS readings, reading n is stored at
+// n % INDOOR_HISTORY_READINGS. Survives deep sleep, but not a power loss or
+// reset.
+RTC_DATA_ATTR static indoor_reading_t indoorRing[INDOOR_HISTORY_READINGS];
+RTC_DATA_ATTR static uint32_t indoorReadings;
+
+/* Stores the indoor reading of this wake. Readings are only kept once the time
+ * has been synchronized, the clock keeps running through deep sleep so later
+ * wakes are dated even if WiFi fails.
+ */
+void recordIndoorReading(float inTemp, float inHumidity)
+{
+  time_t now = time(nullptr);
+  if (now < 1577836800) // 2020-01-01, the time was never set
+  {
+    return;
+  }
+  if (std::isnan(inTemp) && std::isnan(inHumidity))
+  {
+    return;
+  }
+
+  indoor_reading_t &r = indoorRing[indoorReadings % INDOOR_HISTORY_READINGS];
+  r.time = now;
+  r.temp = std::isnan(inTemp)
+           ? INT16_MIN
+           : static_cast<int16_t>(std::round(
+               std::min(std::max(inTemp, -300.f), 300.f) * 100));
+  r.humidity = std::isnan(inHumidity)
+               ? UINT8_MAX
+               : static_cast<uint8_t>(std::round(
+                   std::min(std::max(inHumidity, 0.f), 100.f)));
+  ++indoorReadings;
+  return;
+} // end recordIndoorReading
+
+/* Copies the readings taken at or after since into readings, which must hold
+ * INDOOR_HISTORY_READINGS, oldest first. Returns how many were copied.
+ */
+int getIndoorHistory(indoor_reading_t *readings, time_t since)
+{
+  int n = 0;
+  uint32_t seq = indoorReadings > INDOOR_HISTORY_READINGS
+                 ? indoorReadings - INDOOR_HISTORY_READINGS : 0;
+  for (; seq < indoorReadings; ++seq)
+  {
+    const indoor_reading_t &r = indoorRing[seq % INDOOR_HISTORY_READINGS];
+    if (r.time >= since)
+    {
+      readings[n++] = r;
+    }
+  }
+  return n;
+} // end getIndoorHistory
+
+/* Returns the lowest and highest indoor temperature and humidity read at or
+ * after since.
+ */
+indoor_range_t getIndoorRange(time_t since)
+{
+  indoor_range_t range = {NAN, NAN, NAN, NAN};
+  const uint32_t n = indoorReadings < INDOOR_HISTORY_READINGS
+                     ? indoorReadings : INDOOR_HISTORY_READINGS;
+  for (uint32_t i = 0; i < n; ++i)
+  {
+    const indoor_reading_t &r = indoorRing[i];
+    if (r.time < since)
+    {
+      continue;
+    }
+    if (r.temp != INT16_MIN)
+    {
+      const float t = r.temp / 100.f;
+      range.temp_min = std::isnan(range.temp_min) ? t
+                       : std::min(range.temp_min, t);
+      range.temp_max = std::isnan(range.temp_max) ? t
+                       : std::max(range.temp_max, t);
+    }
+    if (r.humidity != UINT8_MAX)
+    {
+      const float h = r.humidity;
+      range.humidity_min = std::isnan(range.humidity_min) ? h
+                           : std::min(range.humidity_min, h);
+      range.humidity_max = std::isnan(range.humidity_max) ? h
+                           : std::max(range.humidity_max, h);
+    }
+  }
+  return range;
+} // end getIndoorRange
+
+/* Prints the indoor range over the last 24 hours.
+ */
+void printIndoorRange()
+{
+#if DEBUG_LEVEL >= 1
+  const indoor_range_t range = getIndoorRange(time(nullptr) - 86400);
+  Serial.printf("[debug] Indoor 24h : %.1f..%.1f C, %.0f..%.0f %%\n",
+                range.temp_min, range.temp_max,
+                range.humidity_min, range.humidity_max);
+#endif
+  return;
+} // end printIndoorRange
+
+#endif
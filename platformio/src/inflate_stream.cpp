@@ -0,0 +1,592 @@
+/* Inflating stream for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <initializer_list>
+
+#include "inflate_stream.h"
+
+static const uint32_t WINDOW_MASK = INFLATE_WINDOW_SIZE - 1;
+
+// base lengths and extra bits for length codes 257..285
+static const uint16_t LEN_BASE[29] = {
+  3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t LEN_EXTRA[29] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+// base distances and extra bits for distance codes 0..29
+static const uint16_t DIST_BASE[30] = {
+  1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+  257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289,
+  16385, 24577};
+static const uint8_t DIST_EXTRA[30] = {
+  0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+  7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+// order in which code length code lengths are transmitted
+static const uint8_t CLEN_ORDER[19] = {
+  16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+// gzip header flags
+static const uint8_t GZIP_FHCRC    = 0x02;
+static const uint8_t GZIP_FEXTRA   = 0x04;
+static const uint8_t GZIP_FNAME    = 0x08;
+static const uint8_t GZIP_FCOMMENT = 0x10;
+
+InflateStream::InflateStream(Stream &upstream, Format format)
+  : upstream(upstream), format(format), state(STATE_HEADER), window(nullptr),
+    windowPos(0), totalOut(0), bitBuf(0), bitCnt(0), lastBlock(false),
+    storedLeft(0), matchLeft(0), matchDist(0), peeked(-1)
+{
+  lit = {litCounts, litSymbols};
+  dist = {distCounts, distSymbols};
+}
+
+InflateStream::~InflateStream()
+{
+  free(window);
+}
+
+/* Allocates the history window.
+ *
+ * Returns true on success, false if there is not enough free heap.
+ */
+bool InflateStream::begin()
+{
+  if (window == nullptr)
+  {
+    window = static_cast<uint8_t *>(malloc(INFLATE_WINDOW_SIZE));
+  }
+  if (window == nullptr)
+  {
+    state = STATE_ERROR;
+    return false;
+  }
+  return true;
+} // end begin
+
+/* Returns true if the compressed data was malformed or truncated.
+ */
+bool InflateStream::failed() const
+{
+  return state == STATE_ERROR;
+} // end failed
+
+int InflateStream::available()
+{
+  if (peeked >= 0)
+  {
+    return 1;
+  }
+  if (state == STATE_DONE || state == STATE_ERROR)
+  {
+    return 0;
+  }
+  if (matchLeft > 0)
+  {
+    return matchLeft;
+  }
+  return upstream.available() > 0 ? 1 : 0;
+}
+
+int InflateStream::read()
+{
+  if (peeked >= 0)
+  {
+    int c = peeked;
+    peeked = -1;
+    return c;
+  }
+  return nextByte();
+}
+
+int InflateStream::peek()
+{
+  if (peeked < 0)
+  {
+    peeked = nextByte();
+  }
+  return peeked;
+}
+
+size_t InflateStream::readBytes(char *buffer, size_t length)
+{
+  size_t count = 0;
+  while (count < length)
+  {
+    int c = read();
+    if (c < 0)
+    {
+      break;
+    }
+    buffer[count++] = static_cast<char>(c);
+  }
+  return count;
+}
+
+size_t InflateStream::write(uint8_t)
+{
+  return 0;
+}
+
+/* Decodes until the next byte of output is produced.
+ *
+ * Returns the byte, or -1 once the final block has been consumed or an error
+ * occurred.
+ */
+int InflateStream::nextByte()
+{
+  while (true)
+  {
+    switch (state)
+    {
+    case STATE_HEADER:
+      if (window == nullptr || !readHeader())
+      {
+        return fail();
+      }
+      state = STATE_BLOCK;
+      break;
+
+    case STATE_BLOCK:
+      if (lastBlock)
+      {
+        state = STATE_DONE;
+        return -1;
+      }
+      if (!readBlockHeader())
+      {
+        return fail();
+      }
+      break;
+
+    case STATE_STORED:
+    {
+      if (storedLeft == 0)
+      {
+        state = STATE_BLOCK;
+        break;
+      }
+      int c = getBits(8);
+      if (c < 0)
+      {
+        return fail();
+      }
+      --storedLeft;
+      return emit(c);
+    }
+
+    case STATE_HUFFMAN:
+    {
+      if (matchLeft > 0)
+      {
+        --matchLeft;
+        return emit(window[(windowPos - matchDist) & WINDOW_MASK]);
+      }
+      int sym = decode(lit);
+      if (sym < 0)
+      {
+        return fail();
+      }
+      if (sym < 256)
+      {
+        return emit(sym);
+      }
+      if (sym == 256)
+      {
+        state = STATE_BLOCK;
+        break;
+      }
+      sym -= 257;
+      if (sym >= 29)
+      {
+        return fail();
+      }
+      int extra = getBits(LEN_EXTRA[sym]);
+      int dsym = decode(dist);
+      if (extra < 0 || dsym < 0 || dsym >= 30)
+      {
+        return fail();
+      }
+      int dextra = getBits(DIST_EXTRA[dsym]);
+      if (dextra < 0)
+      {
+        return fail();
+      }
+      matchLeft = LEN_BASE[sym] + extra;
+      matchDist = DIST_BASE[dsym] + dextra;
+      if (matchDist > totalOut)
+      {
+        return fail();
+      }
+      break;
+    }
+
+    case STATE_DONE:
+    case STATE_ERROR:
+    default:
+      return -1;
+    }
+  }
+} // end nextByte
+
+int InflateStream::fail()
+{
+  state = STATE_ERROR;
+  return -1;
+}
+
+int InflateStream::emit(uint8_t c)
+{
+  window[windowPos++ & WINDOW_MASK] = c;
+  if (totalOut < INFLATE_WINDOW_SIZE)
+  {
+    ++totalOut;
+  }
+  return c;
+}
+
+/* Reads the next whole byte from upstream, honoring the upstream timeout.
+ *
+ * Returns the byte or -1 if upstream ran dry.
+ */
+int InflateStream::getByte()
+{
+  char c;
+  if (upstream.readBytes(&c, 1) != 1)
+  {
+    return -1;
+  }
+  return static_cast<uint8_t>(c);
+}
+
+/* Reads need (0..16) bits, least significant bit first.
+ *
+ * Returns the bits or -1 if upstream ran dry.
+ */
+int InflateStream::getBits(int need)
+{
+  while (bitCnt < need)
+  {
+    int c = getByte();
+    if (c < 0)
+    {
+      return -1;
+    }
+    bitBuf |= static_cast<uint32_t>(c) << bitCnt;
+    bitCnt += 8;
+  }
+  int val = bitBuf & ((1UL << need) - 1);
+  bitBuf >>= need;
+  bitCnt -= need;
+  return val;
+}
+
+/* Decodes one symbol using canonical Huffman code h. Codes are packed most
+ * significant bit first, so they are assembled one bit at a time.
+ *
+ * Returns the symbol or -1 if the code is invalid or upstream ran dry.
+ */
+int InflateStream::decode(const Huffman &h)
+{
+  int code = 0;  // bits read so far
+  int first = 0; // first code of current length
+  int index = 0; // index of first code of current length in symbols
+  for (int len = 1; len < 16; ++len)
+  {
+    int bit = getBits(1);
+    if (bit < 0)
+    {
+      return -1;
+    }
+    code |= bit;
+    int count = h.counts[len];
+    if (code - count < first)
+    {
+      return h.symbols[index + (code - first)];
+    }
+    index += count;
+    first += count;
+    first <<= 1;
+    code <<= 1;
+  }
+  return -1;
+} // end decode
+
+/* Builds the canonical Huffman decoding tables from a list of code lengths.
+ */
+void InflateStream::buildHuffman(Huffman &h, const uint8_t *lengths, int n)
+{
+  uint16_t offs[16];
+  memset(h.counts, 0, 16 * sizeof(uint16_t));
+  for (int i = 0; i < n; ++i)
+  {
+    ++h.counts[lengths[i]];
+  }
+  h.counts[0] = 0;
+  uint16_t sum = 0;
+  for (int len = 0; len < 16; ++len)
+  {
+    offs[len] = sum;
+    sum += h.counts[len];
+  }
+  for (int i = 0; i < n; ++i)
+  {
+    if (lengths[i] != 0)
+    {
+      h.symbols[offs[lengths[i]]++] = i;
+    }
+  }
+} // end buildHuffman
+
+/* Consumes the gzip or zlib wrapper ahead of the deflate data. A deflate
+ * stream without zlib wrapper is accepted too, in which case the two bytes
+ * read are handed back to the bit reader.
+ *
+ * Returns true if the header is valid.
+ */
+bool InflateStream::readHeader()
+{
+  int b0 = getByte();
+  int b1 = getByte();
+  if (b0 < 0 || b1 < 0)
+  {
+    return false;
+  }
+
+  if (format == DEFLATE)
+  {
+    if ((b0 & 0x0F) == 8 && (b0 >> 4) <= 7 && (b1 & 0x20) == 0
+     && ((b0 << 8) | b1) % 31 == 0)
+    {
+      return true; // zlib header, no preset dictionary
+    }
+    bitBuf = b0 | (b1 << 8);
+    bitCnt = 16;
+    return true;
+  }
+
+  int method = getByte();
+  int flags = getByte();
+  if (b0 != 0x1F || b1 != 0x8B || method != 8 || flags < 0)
+  {
+    return false;
+  }
+  // skip MTIME, XFL and OS
+  for (int i = 0; i < 6; ++i)
+  {
+    if (getByte() < 0)
+    {
+      return false;
+    }
+  }
+  if (flags & GZIP_FEXTRA)
+  {
+    int lo = getByte();
+    int hi = getByte();
+    if (lo < 0 || hi < 0)
+    {
+      return false;
+    }
+    for (int n = lo | (hi << 8); n > 0; --n)
+    {
+      if (getByte() < 0)
+      {
+        return false;
+      }
+    }
+  }
+  // FNAME and FCOMMENT are zero-terminated
+  for (uint8_t f : {GZIP_FNAME, GZIP_FCOMMENT})
+  {
+    if (flags & f)
+    {
+      int c;
+      do
+      {
+        c = getByte();
+      } while (c > 0);
+      if (c < 0)
+      {
+        return false;
+      }
+    }
+  }
+  if (flags & GZIP_FHCRC)
+  {
+    if (getByte() < 0 || getByte() < 0)
+    {
+      return false;
+    }
+  }
+  return true;
+} // end readHeader
+
+/* Reads a block header and prepares the state for the block contents.
+ *
+ * Returns true if the block header is valid.
+ */
+bool InflateStream::readBlockHeader()
+{
+  int hdr = getBits(3);
+  if (hdr < 0)
+  {
+    return false;
+  }
+  lastBlock = hdr & 1;
+
+  switch (hdr >> 1)
+  {
+  case 0: // stored
+  {
+    // discard remaining bits of the current byte
+    getBits(bitCnt & 7);
+    int len = getBits(16);
+    int nlen = getBits(16);
+    if (len < 0 || nlen < 0)
+    {
+      return false;
+    }
+    if (len != (~nlen & 0xFFFF))
+    {
+      return false;
+    }
+    storedLeft = len;
+    state = STATE_STORED;
+    return true;
+  }
+
+  case 1: // fixed Huffman codes
+  {
+    uint8_t lengths[288];
+    int i = 0;
+    for (; i < 144; ++i) lengths[i] = 8;
+    for (; i < 256; ++i) lengths[i] = 9;
+    for (; i < 280; ++i) lengths[i] = 7;
+    for (; i < 288; ++i) lengths[i] = 8;
+    buildHuffman(lit, lengths, 288);
+    for (i = 0; i < 30; ++i) lengths[i] = 5;
+    buildHuffman(dist, lengths, 30);
+    state = STATE_HUFFMAN;
+    return true;
+  }
+
+  case 2: // dynamic Huffman codes
+    if (!readDynamicTables())
+    {
+      return false;
+    }
+    state = STATE_HUFFMAN;
+    return true;
+
+  default:
+    return false;
+  }
+} // end readBlockHeader
+
+/* Reads the code length encoded literal/length and distance code tables of a
+ * dynamic block.
+ *
+ * Returns true if the tables are valid.
+ */
+bool InflateStream::readDynamicTables()
+{
+  uint8_t lengths[288 + 30];
+  int nlen = getBits(5);
+  int ndist = getBits(5);
+  int ncode = getBits(4);
+  if (nlen < 0 || ndist < 0 || ncode < 0)
+  {
+    return false;
+  }
+  nlen += 257;
+  ndist += 1;
+  ncode += 4;
+  if (nlen > 286 || ndist > 30)
+  {
+    return false;
+  }
+
+  // code length code, decoded with the distance table's storage
+  memset(lengths, 0, 19);
+  for (int i = 0; i < ncode; ++i)
+  {
+    int len = getBits(3);
+    if (len < 0)
+    {
+      return false;
+    }
+    lengths[CLEN_ORDER[i]] = len;
+  }
+  uint16_t clenSymbols[19];
+  Huffman clen = {distCounts, clenSymbols};
+  buildHuffman(clen, lengths, 19);
+
+  int i = 0;
+  while (i < nlen + ndist)
+  {
+    int sym = decode(clen);
+    if (sym < 0)
+    {
+      return false;
+    }
+    if (sym < 16)
+    {
+      lengths[i++] = sym;
+      continue;
+    }
+
+    int len = 0;
+    int rep;
+    if (sym == 16)
+    {
+      if (i == 0)
+      {
+        return false;
+      }
+      len = lengths[i - 1];
+      rep = getBits(2);
+      rep = rep < 0 ? -1 : 3 + rep;
+    }
+    else if (sym == 17)
+    {
+      rep = getBits(3);
+      rep = rep < 0 ? -1 : 3 + rep;
+    }
+    else
+    {
+      rep = getBits(7);
+      rep = rep < 0 ? -1 : 11 + rep;
+    }
+    if (rep < 0 || i + rep > nlen + ndist)
+    {
+      return false;
+    }
+    while (rep--)
+    {
+      lengths[i++] = len;
+    }
+  }
+
+  if (lengths[256] == 0)
+  {
+    return false; // no end-of-block code
+  }
+  buildHuffman(lit, lengths, nlen);
+  buildHuffman(dist, lengths + nlen, ndist);
+  return true;
+} // end readDynamicTables
@@ -18,10 +18,18 @@
 #include <Preferences.h>
 
 #include "_locale.h"
+#include "battery_ulp.h"
 #include "client_utils.h"
 #include "renderer.h"
 #include "icons/icons_196x196.h"
 #include "display_utils.h"
+#include "energy.h"
+#include "heap_tracker.h"
+#include "iaq.h"
+#include "indoor_history.h"
+#include "power_tier.h"
+#include "profiler.h"
+#include "telemetry.h"
 
 #if SENSOR == BME280
   #include <Adafruit_BME280.h>
@@ -35,11 +43,60 @@ static owm_resp_air_pollution_t owm_air_pollution;
 
 Preferences prefs;
 
+#if ADAPTIVE_SLEEP
+/* Returns the minutes to sleep until the next refresh, a multiple of
+ * SLEEP_DURATION_MIN. While the coming hours are stable the interval is
+ * stretched up to the first expected change (or SLEEP_DURATION_MAX), when a
+ * change is expected before the next regular refresh it is cut to
+ * SLEEP_DURATION_MIN. The coming hours are compared to the hour in progress,
+ * so a change that has already happened does not count. Thresholds are
+ * defined in config.cpp.
+ */
+int calcSleepInterval(const owm_resp_onecall_t &r, int64_t now)
+{
+  // the hour in progress, the first one that has not passed, the hours after
+  // it are all upcoming
+  int i = 0;
+  while (i < OWM_NUM_HOURLY - 1 && r.hourly[i].dt + 3600 <= now)
+  {
+    ++i;
+  }
+  const owm_hourly_t &base = r.hourly[i];
+  if (r.alerts.num > 0 || base.pop >= ADAPTIVE_SLEEP_POP)
+  { // alerts are in effect or it is (likely) precipitating, nothing is stable
+    return SLEEP_DURATION;
+  }
+
+  int64_t change = now + SLEEP_DURATION_MAX * 60;
+  for (++i; i < OWM_NUM_HOURLY && r.hourly[i].dt < change; ++i)
+  {
+    const owm_hourly_t &h = r.hourly[i];
+    if (std::fabs(h.temp - base.temp) >= ADAPTIVE_SLEEP_TEMP_DELTA
+     || h.pop >= ADAPTIVE_SLEEP_POP
+     || getConditionGroup(h.id) != getConditionGroup(base.id))
+    {
+      change = h.dt;
+      break;
+    }
+  }
+
+  int minutes = (change - now) / 60;
+  if (minutes < SLEEP_DURATION)
+  { // wake more often ahead of the change
+    return SLEEP_DURATION_MIN;
+  }
+  return minutes - minutes % SLEEP_DURATION_MIN;
+} // end calcSleepInterval
+#endif
+
 /* Put esp32 into ultra low-power deep sleep (<11μA).
  * Aligns wake time to the minute. Sleep times defined in config.cpp.
+ * sleepInterval is the number of minutes until the next refresh, a multiple of
+ * SLEEP_DURATION_MIN with adaptive sleep, otherwise SLEEP_DURATION.
  */
-void beginDeepSleep(unsigned long startTime, tm *timeInfo)
+void beginDeepSleep(unsigned long startTime, tm *timeInfo, int sleepInterval)
 {
+  PROFILE_SCOPE(PROF_SLEEP_ENTRY);
   if (!getLocalTime(timeInfo))
   {
     Serial.println(TXT_REFERENCING_OLDER_TIME_NOTICE);
@@ -51,6 +108,13 @@ void beginDeepSleep(unsigned long startTime, tm *timeInfo)
   // aligned and it can easily be deterimined whether we must sleep for
   // additional time due to bedtime.
   // i.e. when curHour == 0, then timeInfo->tm_hour == WAKE_TIME
+  // Wake times are aligned to a grid of SLEEP_DURATION (SLEEP_DURATION_MIN
+  // with adaptive sleep) minutes.
+#if ADAPTIVE_SLEEP
+  const int grid = SLEEP_DURATION_MIN;
+#else
+  const int grid = SLEEP_DURATION;
+#endif
   int bedtimeHour = INT_MAX;
   if (BED_TIME != WAKE_TIME)
   {
@@ -61,16 +125,16 @@ void beginDeepSleep(unsigned long startTime, tm *timeInfo)
   int curHour = (timeInfo->tm_hour - WAKE_TIME + 24) % 24;
   const int curMinute = curHour * 60 + timeInfo->tm_min;
   const int curSecond = curHour * 3600 + timeInfo->tm_min * 60 + timeInfo->tm_sec;
-  const int desiredSleepSeconds = SLEEP_DURATION * 60;
-  const int offsetMinutes = curMinute % SLEEP_DURATION;
-  const int offsetSeconds = curSecond % desiredSleepSeconds;
-
-  // align wake time to nearest multiple of SLEEP_DURATION
-  int sleepMinutes = SLEEP_DURATION - offsetMinutes;
-  if (desiredSleepSeconds - offsetSeconds < 120 || offsetSeconds / (float)desiredSleepSeconds > 0.95f)
-  { // if we have a sleep time less than 2 minutes OR less 5% SLEEP_DURATION,
-    // skip to next alignment
-    sleepMinutes += SLEEP_DURATION;
+  const int gridSeconds = grid * 60;
+  const int offsetMinutes = curMinute % grid;
+  const int offsetSeconds = curSecond % gridSeconds;
+
+  // align wake time to nearest multiple of grid
+  int sleepMinutes = sleepInterval - offsetMinutes;
+  if (gridSeconds - offsetSeconds < 120 || offsetSeconds / (float)gridSeconds > 0.95f)
+  { // if we are less than 2 minutes OR less than 5% of the grid ahead of an
+    // alignment, we woke early for it, skip to the next alignment
+    sleepMinutes += grid;
   }
 
   // estimated wake time, if this falls in a sleep period then sleepDuration
@@ -92,18 +156,65 @@ void beginDeepSleep(unsigned long startTime, tm *timeInfo)
   sleepDuration += 3ULL;
   sleepDuration *= 1.0015f;
 
+  HEAP_CHECKPOINT(HEAP_SLEEP);
 #if DEBUG_LEVEL >= 1
   printHeapUsage();
 #endif
+#if HEAP_TRACKING
+  printHeapCheckpoints();
+#endif
+#if ULP_BATTERY_MONITORING && DEBUG_LEVEL >= 1
+  printBatteryUlpHistory();
+#endif
 
   esp_sleep_enable_timer_wakeup(sleepDuration * 1000000ULL);
+#if ULP_BATTERY_MONITORING
+  // wake early to show the low battery warning
+  startBatteryUlp(LOW_BATTERY_VOLTAGE - ULP_BATTERY_HYSTERESIS, UINT32_MAX);
+#endif
   Serial.print(TXT_AWAKE_FOR);
   Serial.println(" " + String((millis() - startTime) / 1000.0, 3) + "s");
   Serial.print(TXT_ENTERING_DEEP_SLEEP_FOR);
   Serial.println(" " + String(sleepDuration) + "s");
+#if PHASE_PROFILING
+  const profile_cycle_t &cycle __attribute__((unused)) =
+    finishProfile(sleepInterval);
+#endif
+#if ENERGY_ESTIMATION
+  printEnergyEstimate(cycle);
+#endif
+#if TELEMETRY
+  commitTelemetry(&cycle);
+#endif
   esp_deep_sleep_start();
 } // end beginDeepSleep
 
+/* Reports the outcome of reading the BME, sets statusStr if it failed.
+ */
+void reportBmeReading(bool found, float inTemp, float inHumidity,
+                      String &statusStr)
+{
+  if (!found)
+  {
+    statusStr = "BME " + String(TXT_NOT_FOUND); // check wiring
+    Serial.println(statusStr);
+  }
+  // check if BME readings are valid
+  // note: readings are checked again before drawing to screen. If a reading
+  //       is not a number (NAN) then an error occurred, a dash '-' will be
+  //       displayed.
+  else if (std::isnan(inTemp) || std::isnan(inHumidity))
+  {
+    statusStr = "BME " + String(TXT_READ_FAILED);
+    Serial.println(statusStr);
+  }
+  else
+  {
+    Serial.println(TXT_SUCCESS);
+  }
+  return;
+} // end reportBmeReading
+
 /* Setup Wi-Fi and time */
 bool setupWifi(int &wifiRSSI, tm *timeInfo) {
   // START WIFI
@@ -141,6 +252,10 @@ void setup()
 {
   unsigned long startTime = millis();
   Serial.begin(115200);
+  HEAP_CHECKPOINT(HEAP_BOOT);
+#if TELEMETRY
+  beginTelemetry();
+#endif
 
 #if DEBUG_LEVEL >= 1
   printHeapUsage();
@@ -151,36 +266,59 @@ void setup()
   // Open namespace for read/write to non-volatile storage
   prefs.begin(NVS_NAMESPACE, false);
 
+#if ULP_BATTERY_MONITORING
+  collectBatteryUlp();
+#endif
+
 #if BATTERY_MONITORING
   uint32_t batteryVoltage = readBatteryVoltage();
   Serial.print(TXT_BATTERY_VOLTAGE);
   Serial.println(": " + String(batteryVoltage) + "mv");
+#if TELEMETRY
+  telemetry.battery_mv = batteryVoltage;
+#endif
 
   // When the battery is low, the display should be updated to reflect that, but
   // only the first time we detect low voltage. The next time the display will
   // refresh is when voltage is no longer low. To keep track of that we will
-  // make use of non-volatile storage.
-  bool lowBat = prefs.getBool("lowBat", false);
+  // make use of non-volatile storage. The previous state also provides the
+  // hysteresis of getBatteryState.
+  const battery_state_t prevBatState = static_cast<battery_state_t>(
+    prefs.getUChar("batState", BATTERY_OK));
+  const battery_state_t batState = getBatteryState(batteryVoltage,
+                                                   prevBatState);
+  if (batState != prevBatState)
+  {
+    prefs.putUChar("batState", batState);
+  }
 
   // low battery, deep sleep now
-  if (batteryVoltage <= LOW_BATTERY_VOLTAGE)
+  if (batState != BATTERY_OK)
   {
-    if (lowBat == false)
+    if (prevBatState == BATTERY_OK)
     { // battery is now low for the first time
-      prefs.putBool("lowBat", true);
       prefs.end();
       drawError(battery_alert_0deg_196x196, TXT_LOW_BATTERY);
       powerOffDisplay();
     }
 
-    if (batteryVoltage <= CRIT_LOW_BATTERY_VOLTAGE)
+    if (batState == BATTERY_CRIT_LOW)
     { // critically low battery
       // don't set esp_sleep_enable_timer_wakeup();
       // We won't wake up again until someone manually presses the RST button.
       Serial.println(TXT_CRIT_LOW_BATTERY_VOLTAGE);
       Serial.println(TXT_HIBERNATING_INDEFINITELY_NOTICE);
     }
-    else if (batteryVoltage <= VERY_LOW_BATTERY_VOLTAGE)
+#if ULP_BATTERY_MONITORING
+    else if (startBatteryUlp(CRIT_LOW_BATTERY_VOLTAGE - ULP_BATTERY_HYSTERESIS,
+                             LOW_BATTERY_VOLTAGE + BATTERY_HYSTERESIS
+                             + ULP_BATTERY_HYSTERESIS))
+    { // low battery, the ULP wakes us once it is charged or critically low
+      Serial.println(TXT_LOW_BATTERY_VOLTAGE);
+    }
+    // otherwise wake on a timer, as without the ULP
+#endif
+    else if (batState == BATTERY_VERY_LOW)
     { // very low battery
       esp_sleep_enable_timer_wakeup(VERY_LOW_BATTERY_SLEEP_INTERVAL * 60ULL * 1000000ULL);
       Serial.println(TXT_VERY_LOW_BATTERY_VOLTAGE);
@@ -194,23 +332,33 @@ void setup()
       Serial.print(TXT_ENTERING_DEEP_SLEEP_FOR);
       Serial.println(" " + String(LOW_BATTERY_SLEEP_INTERVAL) + "min");
     }
+#if TELEMETRY
+    commitTelemetry(NULL);
+#endif
     esp_deep_sleep_start();
   }
-  // battery is no longer low, reset variable in non-volatile storage
-  if (lowBat == true)
+#if POWER_TIERS
+  powerTier = getPowerTier(batteryVoltage);
+  if (powerTier != POWER_TIER_NORMAL)
   {
-    prefs.putBool("lowBat", false);
+    Serial.println(String(TXT_POWER_SAVER) + " " + String(powerTier));
   }
+#endif
 #else
   uint32_t batteryVoltage = UINT32_MAX;
 #endif
 
+#ifdef POS_IN_IAQ
+  loadGasBaseline(prefs);
+#endif
+
   // All data should have been loaded from NVS. Close filesystem.
   prefs.end();
 
   String statusStr = {};
 
   // GET INDOOR TEMPERATURE AND HUMIDITY, start BMEx80...
+  PROFILE_BEGIN(bmeScope, PROF_BME);
   pinMode(PIN_BME_PWR, OUTPUT);
   digitalWrite(PIN_BME_PWR, HIGH);
   delay(11);
@@ -218,54 +366,102 @@ void setup()
   I2C_bme.begin(PIN_BME_SDA, PIN_BME_SCL, 100000); // 100kHz
   float inTemp     = NAN;
   float inHumidity = NAN;
+#ifdef POS_IN_IAQ
+  int inIaq        = -1;
+#endif
 
 #if SENSOR == BME280
   Serial.print(String(TXT_READING_FROM) + " BME280... ");
   Adafruit_BME280 bme;
 
-  if (bme.begin(BME_ADDRESS, &I2C_bme))
+  const bool bmeFound = bme.begin(BME_ADDRESS, &I2C_bme);
+  if (bmeFound)
   {
+    inTemp     = bme.readTemperature(); // Celsius
+    inHumidity = bme.readHumidity();    // %
+  }
+  reportBmeReading(bmeFound, inTemp, inHumidity, statusStr);
+  digitalWrite(PIN_BME_PWR, LOW);
 #elif SENSOR == BME680
-  Serial.print(String(TXT_READING_FROM) + " BME680... ");
+  // The measurement is started now and collected after WiFi has connected, so
+  // the gas heater (when used) and the conversion run in parallel with it.
   Adafruit_BME680 bme(&I2C_bme);
 
-  if (bme.begin(BME_ADDRESS))
+  bool bmeFound = bme.begin(BME_ADDRESS);
+  if (bmeFound)
   {
+#ifdef POS_IN_IAQ
+    bme.setGasHeater(320, 150); // Celsius, ms
+#else
+    bme.setGasHeater(0, 0); // the heater is only needed for air quality
 #endif
-    inTemp     = bme.readTemperature(); // Celsius
-    inHumidity = bme.readHumidity();    // %
-
-    // check if BME readings are valid
-    // note: readings are checked again before drawing to screen. If a reading
-    //       is not a number (NAN) then an error occurred, a dash '-' will be
-    //       displayed.
-    if (std::isnan(inTemp) || std::isnan(inHumidity))
-    {
-      statusStr = "BME " + String(TXT_READ_FAILED);
-      Serial.println(statusStr);
-    }
-    else
-    {
-      Serial.println(TXT_SUCCESS);
-    }
-  }
-  else
-  {
-    statusStr = "BME " + String(TXT_NOT_FOUND); // check wiring
-    Serial.println(statusStr);
+    bmeFound = bme.beginReading() != 0;
   }
-  digitalWrite(PIN_BME_PWR, LOW);
+#endif
+  PROFILE_END(bmeScope);
 
   tm timeInfo = {};
 
   int wifiRSSI = 0; // “Received Signal Strength Indicator"
 
   bool dataSuccess = setupWifi(wifiRSSI, &timeInfo);
+#if TELEMETRY
+  telemetry.rssi = wifiRSSI;
+#endif
+
+#if SENSOR == BME680
+  PROFILE_BEGIN(bmeReadScope, PROF_BME);
+  Serial.print(String(TXT_READING_FROM) + " BME680... ");
+  if (bmeFound && bme.endReading())
+  {
+    inTemp     = bme.temperature; // Celsius
+    inHumidity = bme.humidity;    // %
+#ifdef POS_IN_IAQ
+    // gas_resistance (ohms) is 0 if the heater plate did not reach its
+    // temperature, the index is then unknown
+    inIaq = calcIaq(bme.gas_resistance, inHumidity);
+#endif
+  }
+  reportBmeReading(bmeFound, inTemp, inHumidity, statusStr);
+  digitalWrite(PIN_BME_PWR, LOW);
+  PROFILE_END(bmeReadScope);
+#ifdef POS_IN_IAQ
+  if (gasBaselineStale())
+  {
+    prefs.begin(NVS_NAMESPACE, false);
+    saveGasBaseline(prefs);
+    prefs.end();
+  }
+#endif
+#endif
+
+#if INDOOR_HISTORY
+  // after the time is synchronized, to date the reading
+  recordIndoorReading(inTemp, inHumidity);
+#if DEBUG_LEVEL >= 1
+  printIndoorRange();
+#endif
+#endif
   if (dataSuccess) {
     dataSuccess = makeAPICalls(owm_onecall, owm_air_pollution);
   }
+#if TELEMETRY
+  uploadTelemetry();
+#endif
+#ifdef POS_AIR_QUALITY
+  if (dataSuccess) {
+    calcAirQuality(owm_air_pollution);
+  }
+#endif
 
   killWiFi(); // WiFi no longer needed
+  HEAP_CHECKPOINT(HEAP_WIFI_OFF);
+
+  // The indoor readings are normally updated with two partial refreshes after
+  // the full refresh, each driving the panel again. When saving power they are
+  // drawn with the rest instead.
+  const bool indoorInFullRefresh = dataSuccess
+                                   && powerTier >= POWER_TIER_3;
 
   if (dataSuccess) {
     String refreshTimeStr;
@@ -273,8 +469,14 @@ void setup()
     String dateStr;
     getDateStr(dateStr, &timeInfo);
 
+#if ENERGY_ESTIMATION
+    // the time is set now, which dates the reading for the discharge trend
+    recordBatteryVoltage(batteryVoltage);
+#endif
+
     // RENDER FULL REFRESH
     initDisplay();
+    bool firstPage = true;
     do
     {
       Serial.println("Drawing current conditions");
@@ -289,25 +491,60 @@ void setup()
       if (DISPLAY_ALERTS)
       {
         drawAlerts(owm_onecall.alerts, CITY_STRING, dateStr);
+        if (firstPage)
+        { // once, not for every page of the panel
+          HEAP_CHECKPOINT(HEAP_ALERTS);
+        }
       }
       drawStatusBar(statusStr, refreshTimeStr, wifiRSSI, batteryVoltage);
-    } while (display.nextPage());
+      if (indoorInFullRefresh)
+      {
+#ifdef POS_IN_TEMP
+        drawCurrentInTemp(inTemp);
+#endif
+#ifdef POS_IN_HUMIDITY
+        drawCurrentInHumidity(inHumidity);
+#endif
+#ifdef POS_IN_IAQ
+        drawCurrentInIaq(inIaq);
+#endif
+      }
+      firstPage = false;
+    } while (displayNextPage());
+    HEAP_CHECKPOINT(HEAP_RENDER);
   }
 
-  // Render indoor temperature and humidity
+  // Render indoor temperature, humidity and air quality
+  if (!indoorInFullRefresh)
+  {
 #ifdef POS_IN_TEMP
-  Serial.println("Drawing indoor temperature");
-  drawCurrentInTemp(inTemp);
+    Serial.println("Drawing indoor temperature");
+    refreshCurrentInTemp(inTemp);
 #endif
 #ifdef POS_IN_HUMIDITY
-  Serial.println("Drawing indoor humidity");
-  drawCurrentInHumidity(inHumidity);
+    Serial.println("Drawing indoor humidity");
+    refreshCurrentInHumidity(inHumidity);
+#endif
+#ifdef POS_IN_IAQ
+    Serial.println("Drawing indoor air quality");
+    refreshCurrentInIaq(inIaq);
 #endif
+  }
 
   powerOffDisplay();
 
   // DEEP SLEEP
-  beginDeepSleep(startTime, &timeInfo);
+  int sleepInterval = SLEEP_DURATION;
+#if ADAPTIVE_SLEEP
+  if (dataSuccess)
+  {
+    sleepInterval = calcSleepInterval(owm_onecall, time(nullptr));
+    Serial.print(TXT_NEXT_REFRESH_IN);
+    Serial.println(" " + String(sleepInterval) + "min");
+  }
+#endif
+  sleepInterval = tierSleepInterval(sleepInterval);
+  beginDeepSleep(startTime, &timeInfo, sleepInterval);
 } // end setup
 
 /* This will never run
@@ -0,0 +1,71 @@
+/* Power tiers for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "power_tier.h"
+
+power_tier_t powerTier = POWER_TIER_NORMAL;
+
+/* Returns the power tier for a battery voltage.
+ */
+power_tier_t getPowerTier(uint32_t batVoltage)
+{
+  if (batVoltage <= POWER_TIER_3_VOLTAGE)
+  {
+    return POWER_TIER_3;
+  }
+  if (batVoltage <= POWER_TIER_2_VOLTAGE)
+  {
+    return POWER_TIER_2;
+  }
+  if (batVoltage <= POWER_TIER_1_VOLTAGE)
+  {
+    return POWER_TIER_1;
+  }
+  return POWER_TIER_NORMAL;
+} // end getPowerTier
+
+/* Returns how long to wait for WiFi to connect, ms. A weak network that needs
+ * the full WIFI_TIMEOUT costs more than skipping a refresh.
+ */
+unsigned long wifiTimeout()
+{
+  return powerTier >= POWER_TIER_1 ? POWER_TIER_WIFI_TIMEOUT : WIFI_TIMEOUT;
+} // end wifiTimeout
+
+/* Returns the HTTP connect and read timeout, ms.
+ */
+unsigned httpTimeout()
+{
+  return powerTier >= POWER_TIER_1 ? POWER_TIER_HTTP_TIMEOUT
+                                   : HTTP_CLIENT_TCP_TIMEOUT;
+} // end httpTimeout
+
+/* Returns the sleep interval stretched for the power tier, minutes. Multiples
+ * of the interval stay on the same wake up grid.
+ */
+int tierSleepInterval(int sleepInterval)
+{
+  switch (powerTier)
+  {
+  case POWER_TIER_3:
+    return sleepInterval * 4;
+  case POWER_TIER_2:
+    return sleepInterval * 2;
+  default:
+    return sleepInterval;
+  }
+} // end tierSleepInterval
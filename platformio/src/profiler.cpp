@@ -0,0 +1,216 @@
+/* Wake cycle profiler for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "profiler.h"
+
+#if PHASE_PROFILING
+
+#include <algorithm>
+#include <esp_timer.h>
+
+static const char *const PHASE_NAMES[PROF_NUM_PHASES] =
+{
+  "bme",
+  "wifi",
+  "sntp",
+  "dns",
+  "connect/tls",
+  "first byte",
+  "body read",
+  "json parse",
+  "epd init",
+  "draw current",
+  "draw outlook",
+  "draw forecast",
+  "draw location",
+  "draw alerts",
+  "draw status",
+  "draw indoor",
+  "refresh",
+  "busy wait",
+  "epd off",
+  "sleep entry",
+};
+
+// The most recent cycles are kept in RTC memory, which survives deep sleep.
+RTC_DATA_ATTR static profile_cycle_t profileHistory[PROFILE_HISTORY];
+RTC_DATA_ATTR static uint32_t profileCycles;
+
+static uint32_t phaseUs[PROF_NUM_PHASES];
+static int8_t currentPhase = -1;
+static int64_t currentSince;
+
+/* Charges the time since the last phase change to the current phase.
+ */
+static int64_t charge()
+{
+  int64_t now = esp_timer_get_time();
+  if (currentPhase >= 0)
+  {
+    phaseUs[currentPhase] += now - currentSince;
+  }
+  currentSince = now;
+  return now;
+} // end charge
+
+ProfileScope::ProfileScope(profile_phase_t phase)
+  : parent(currentPhase), ended(false)
+{
+  charge();
+  currentPhase = phase;
+} // end ProfileScope
+
+ProfileScope::~ProfileScope()
+{
+  end();
+} // end ~ProfileScope
+
+void ProfileScope::end()
+{
+  if (!ended)
+  {
+    charge();
+    currentPhase = parent;
+    ended = true;
+  }
+  return;
+} // end ProfileScope::end
+
+ProfiledStream::ProfiledStream(Stream &upstream)
+  : upstream(upstream), count(0) {}
+
+int ProfiledStream::available()
+{
+  return upstream.available();
+}
+
+int ProfiledStream::read()
+{
+  ProfileScope scope(PROF_BODY_READ);
+  int c = upstream.read();
+  count += c >= 0;
+  return c;
+}
+
+int ProfiledStream::peek()
+{
+  ProfileScope scope(PROF_BODY_READ);
+  return upstream.peek();
+}
+
+size_t ProfiledStream::readBytes(char *buffer, size_t length)
+{
+  ProfileScope scope(PROF_BODY_READ);
+  size_t n = upstream.readBytes(buffer, length);
+  count += n;
+  return n;
+}
+
+size_t ProfiledStream::write(uint8_t)
+{
+  return 0;
+}
+
+uint32_t ProfiledStream::bytesRead() const
+{
+  return count;
+}
+
+/* Registered with the display driver, which calls it repeatedly while the
+ * panel signals busy.
+ */
+void profileBusyCallback(const void *)
+{
+  ProfileScope scope(PROF_BUSY);
+  delay(1); // what the driver does without a callback
+  return;
+} // end profileBusyCallback
+
+const char *profilePhaseName(profile_phase_t phase)
+{
+  return PHASE_NAMES[phase];
+} // end profilePhaseName
+
+/* Points cycles to the stored history of finished wake cycles, in no
+ * particular order, and returns how many there are.
+ */
+uint32_t getProfileHistory(const profile_cycle_t *&cycles)
+{
+  cycles = profileHistory;
+  return profileCycles < PROFILE_HISTORY ? profileCycles : PROFILE_HISTORY;
+} // end getProfileHistory
+
+#if DEBUG_LEVEL >= 1
+/* Prints the phase times of this cycle next to the average and maximum over
+ * the cycles in the history, milliseconds.
+ */
+static void printProfile(const profile_cycle_t &cycle)
+{
+  const profile_cycle_t *history;
+  const uint32_t n = getProfileHistory(history);
+  Serial.printf("[debug] %-13s %8s %8s %8s  (%u cycles)\n",
+                "phase", "now", "avg", "max", (unsigned) n);
+  uint32_t attributed = 0;
+  for (int p = 0; p < PROF_NUM_PHASES; ++p)
+  {
+    uint64_t sum = 0;
+    uint32_t max = 0;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      sum += history[i].phase_us[p];
+      max = std::max(max, history[i].phase_us[p]);
+    }
+    attributed += cycle.phase_us[p];
+    if (max == 0)
+    {
+      continue; // never entered, ex. the sensor is not fitted
+    }
+    Serial.printf("[debug] %-13s %8.1f %8.1f %8.1f\n", PHASE_NAMES[p],
+                  cycle.phase_us[p] / 1000.0f, sum / (1000.0f * n),
+                  max / 1000.0f);
+  }
+  Serial.printf("[debug] %-13s %8.1f\n", "other",
+                (cycle.awake_us - attributed) / 1000.0f);
+  Serial.printf("[debug] %-13s %8.1f\n", "awake",
+                cycle.awake_us / 1000.0f);
+  Serial.flush();
+  return;
+} // end printProfile
+#endif
+
+/* Ends the profile of this wake cycle, stores it in the history and returns
+ * it. sleepInterval is the minutes until the next refresh, as passed to
+ * beginDeepSleep. Call immediately before entering deep sleep.
+ */
+const profile_cycle_t &finishProfile(int sleepInterval)
+{
+  profile_cycle_t &cycle = profileHistory[profileCycles % PROFILE_HISTORY];
+  cycle.awake_us = charge();
+  cycle.sleep_min = sleepInterval;
+  for (int p = 0; p < PROF_NUM_PHASES; ++p)
+  {
+    cycle.phase_us[p] = phaseUs[p];
+  }
+  ++profileCycles;
+
+#if DEBUG_LEVEL >= 1
+  printProfile(cycle);
+#endif
+  return cycle;
+} // end finishProfile
+
+#endif
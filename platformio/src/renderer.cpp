@@ -19,9 +19,15 @@
 #include "_strftime.h"
 #include "renderer.h"
 #include "api_response.h"
+#include "calendar.h"
 #include "config.h"
 #include "conversions.h"
 #include "display_utils.h"
+#include "energy.h"
+#include "indoor_history.h"
+#include "power_tier.h"
+#include "profiler.h"
+#include "telemetry.h"
 
 // fonts
 #include FONT_HEADER
@@ -224,6 +230,10 @@ void drawMultiLnString(int16_t x, int16_t y, const String &text,
  */
 void initDisplay()
 {
+  PROFILE_SCOPE(PROF_EPD_INIT);
+#if TELEMETRY
+  setTelemetryRefresh(REFRESH_FULL);
+#endif
   pinMode(PIN_EPD_PWR, OUTPUT);
   digitalWrite(PIN_EPD_PWR, HIGH);
 #if EPD_DRIVER == WAVESHARE
@@ -238,6 +248,10 @@ void initDisplay()
             PIN_EPD_MOSI,
             PIN_EPD_CS);
 
+#if PHASE_PROFILING
+  display.epd2.setBusyCallback(profileBusyCallback);
+#endif
+
   display.setRotation(0);
   display.setTextSize(1);
   display.setTextColor(GxEPD_BLACK);
@@ -252,12 +266,22 @@ void initDisplay()
  */
 void powerOffDisplay()
 {
+  PROFILE_SCOPE(PROF_EPD_OFF);
   display.hibernate(); // turns powerOff() and sets controller to deep sleep for
                        // minimum power use
   digitalWrite(PIN_EPD_PWR, LOW);
   return;
 } // end powerOffDisplay
 
+/* Writes the page drawn to the display, the panel is refreshed after the last
+ * page. Returns true while there are more pages to draw.
+ */
+bool displayNextPage()
+{
+  PROFILE_SCOPE(PROF_REFRESH);
+  return display.nextPage();
+} // end displayNextPage
+
 
 /* These functions are responsible for drawing the current conditions and
  * associated icons on the left panel.
@@ -431,28 +455,22 @@ void drawCurrentAirQuality(const owm_resp_air_pollution_t &owm_air_pollution)
   // labels
   display.setFont(&FONT_7pt8b);
 
-  const char *air_quality_index_label;
-  if (aqi_desc_type(AQI_SCALE) == AIR_QUALITY_DESC)
-  {
-    air_quality_index_label = TXT_AIR_QUALITY;
-  }
-  else // (aqi_desc_type(AQI_SCALE) == AIR_POLLUTION_DESC)
-  {
-    air_quality_index_label = TXT_AIR_POLLUTION;
-  }
-  drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, air_quality_index_label, LEFT);
+  drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY,
+             owm_air_pollution.aqi_label, LEFT);
 
   // spacing between end of index value and start of descriptor text
   const int sp = 8;
 
   // air quality index
   display.setFont(&FONT_12pt8b);
-  const owm_components_t &c = owm_air_pollution.components;
-  // OpenWeatherMap does not provide pb (lead) conentrations, so we pass NULL.
-  int aqi = calc_aqi(AQI_SCALE, c.co, c.nh3, c.no, c.no2, c.o3, NULL, c.so2,
-                                c.pm10, c.pm2_5);
+  // calculated once by calcAirQuality, not per page
+  int aqi = owm_air_pollution.aqi;
   int aqi_max = aqi_scale_max(AQI_SCALE);
-  if (aqi > aqi_max)
+  if (aqi < 0)
+  {
+    dataStr = "--";
+  }
+  else if (aqi > aqi_max)
   {
     dataStr = "> " + String(aqi_max);
   }
@@ -462,7 +480,7 @@ void drawCurrentAirQuality(const owm_resp_air_pollution_t &owm_air_pollution)
   }
   drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
   display.setFont(&FONT_7pt8b);
-  dataStr = String(aqi_desc(AQI_SCALE, aqi));
+  dataStr = String(owm_air_pollution.aqi_desc);
   int max_w = (162 + (PosX * 162) - sp) - (display.getCursorX() + sp);
   if (getStringWidth(dataStr) <= max_w)
   { // Fits on a single line, draw along bottom
@@ -489,50 +507,133 @@ void drawCurrentAirQuality(const owm_resp_air_pollution_t &owm_air_pollution)
 #endif
 // end drawCurrentAirQuality
 
+#if INDOOR_HISTORY && (defined(POS_IN_TEMP) || defined(POS_IN_HUMIDITY))
+/* Draws the indoor temperature or humidity of the last 24 hours as a line
+ * within the given box, scaled to its range. Nothing is drawn until there are
+ * two readings.
+ */
+static void drawIndoorSparkline(int x, int y, int w, int h, bool humidity)
+{
+  if (w < 16)
+  {
+    return;
+  }
+  const time_t now = time(nullptr);
+  const time_t since = now - 86400;
+  indoor_reading_t readings[INDOOR_HISTORY_READINGS];
+  const int n = getIndoorHistory(readings, since);
+  const indoor_range_t range = getIndoorRange(since);
+  float lo = humidity ? range.humidity_min : range.temp_min;
+  float hi = humidity ? range.humidity_max : range.temp_max;
+  if (std::isnan(lo))
+  {
+    return;
+  }
+  if (hi - lo < (humidity ? 4.f : 1.f))
+  { // don't blow small fluctuations up to full height
+    const float mid = (hi + lo) / 2;
+    lo = mid - (humidity ? 2.f : 0.5f);
+    hi = mid + (humidity ? 2.f : 0.5f);
+  }
+
+  int x0 = -1, y0 = -1;
+  for (int i = 0; i < n; ++i)
+  {
+    float v;
+    if (humidity)
+    {
+      if (readings[i].humidity == UINT8_MAX)
+      {
+        continue;
+      }
+      v = readings[i].humidity;
+    }
+    else
+    {
+      if (readings[i].temp == INT16_MIN)
+      {
+        continue;
+      }
+      v = readings[i].temp / 100.f;
+    }
+    const int x1 = x + static_cast<int>((readings[i].time - since)
+                                        * (w - 1) / 86400);
+    const int y1 = y + h - 1 - static_cast<int>(std::round((v - lo)
+                                                * (h - 1) / (hi - lo)));
+    if (x0 >= 0)
+    {
+      display.drawLine(x0, y0, x1, y1, GxEPD_BLACK);
+    }
+    x0 = x1;
+    y0 = y1;
+  }
+  return;
+} // end drawIndoorSparkline
+#endif
+
 // drawCurrentInTemp
 #ifdef POS_IN_TEMP
 void drawCurrentInTemp(float inTemp)
 {
+  PROFILE_SCOPE(PROF_DRAW_INDOOR);
   String dataStr, unitStr;
   int PosX = (POS_IN_TEMP % 2);
   int PosY = static_cast<int>(POS_IN_TEMP / 2);
 
-  display.setPartialWindow(160 * PosX, 204 + (48 + 8) * PosY, 152, 48);
-  display.firstPage();
-  do
-  {
-    // icons
-    display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY,
-                              house_thermometer_48x48, 48, 48, GxEPD_BLACK);
+  // icons
+  display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY,
+                             house_thermometer_48x48, 48, 48, GxEPD_BLACK);
 
-    // labels
-    display.setFont(&FONT_7pt8b);
-    drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_INDOOR_TEMPERATURE, LEFT);
+  // labels
+  display.setFont(&FONT_7pt8b);
+  drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_INDOOR_TEMPERATURE, LEFT);
 
-    // indoor temperature
-    display.setFont(&FONT_12pt8b);
-    if (!std::isnan(inTemp))
+  // indoor temperature
+  display.setFont(&FONT_12pt8b);
+  if (!std::isnan(inTemp))
+  {
+    if (UNITS_TEMP == KELVIN)
     {
-      if (UNITS_TEMP == KELVIN)
-      {
-        dataStr = String(std::round(celsius_to_kelvin(inTemp) * 10) / 10.0f, 1) + 'K';
-      }
-      else if (UNITS_TEMP == CELSIUS)
-      {
-        dataStr = String(std::round(inTemp * 10) / 10.0f, 1) + "\260C";
-      }
-      else if (UNITS_TEMP == FAHRENHEIT)
-      {
-        dataStr = String(static_cast<int>(
-                  std::round(celsius_to_fahrenheit(inTemp)))) + "\260F";
-      }
+      dataStr = String(std::round(celsius_to_kelvin(inTemp) * 10) / 10.0f, 1) + 'K';
     }
-    else
+    else if (UNITS_TEMP == CELSIUS)
     {
-      dataStr = "--";
+      dataStr = String(std::round(inTemp * 10) / 10.0f, 1) + "\260C";
     }
-    drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-  } while (display.nextPage());
+    else if (UNITS_TEMP == FAHRENHEIT)
+    {
+      dataStr = String(static_cast<int>(
+                std::round(celsius_to_fahrenheit(inTemp)))) + "\260F";
+    }
+  }
+  else
+  {
+    dataStr = "--";
+  }
+  drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
+#if INDOOR_HISTORY
+  drawIndoorSparkline(display.getCursorX() + 6, 204 + 16 + (48 + 8) * PosY,
+                      160 * PosX + 150 - (display.getCursorX() + 6), 18,
+                      false);
+#endif
+}
+
+/* Updates the indoor temperature alone with a partial refresh.
+ */
+void refreshCurrentInTemp(float inTemp)
+{
+#if TELEMETRY
+  setTelemetryRefresh(REFRESH_PARTIAL);
+#endif
+  int PosX = (POS_IN_TEMP % 2);
+  int PosY = static_cast<int>(POS_IN_TEMP / 2);
+
+  display.setPartialWindow(160 * PosX, 204 + (48 + 8) * PosY, 152, 48);
+  display.firstPage();
+  do
+  {
+    drawCurrentInTemp(inTemp);
+  } while (displayNextPage());
 }
 #endif
 // end drawCurrentInTemp
@@ -702,44 +803,117 @@ void drawCurrentVisibility(const owm_current_t &current)
 #endif
 // end drawCurrentVisibility
 
-// drawCurrentInHumidit
+// drawCurrentInHumidity
 #ifdef POS_IN_HUMIDITY
 void drawCurrentInHumidity(float inHumidity)
 {
+  PROFILE_SCOPE(PROF_DRAW_INDOOR);
   String dataStr, unitStr;
   int PosX = (POS_IN_HUMIDITY % 2);
   int PosY = static_cast<int>(POS_IN_HUMIDITY / 2);
 
+  // current weather data icons
+  display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY,
+                             house_humidity_48x48, 48, 48, GxEPD_BLACK);
+
+  // current weather data labels
+  display.setFont(&FONT_7pt8b);
+  drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_INDOOR_HUMIDITY, LEFT);
+
+  // indoor humidity
+  display.setFont(&FONT_12pt8b);
+  if (!std::isnan(inHumidity))
+  {
+    dataStr = String(static_cast<int>(std::round(inHumidity)));
+  }
+  else
+  {
+    dataStr = "--";
+  }
+  drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
+  display.setFont(&FONT_8pt8b);
+  drawString(display.getCursorX(), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2,
+             "%", LEFT);
+#if INDOOR_HISTORY
+  drawIndoorSparkline(display.getCursorX() + 6, 204 + 16 + (48 + 8) * PosY,
+                      160 * PosX + 150 - (display.getCursorX() + 6), 18,
+                      true);
+#endif
+}
+
+/* Updates the indoor humidity alone with a partial refresh.
+ */
+void refreshCurrentInHumidity(float inHumidity)
+{
+#if TELEMETRY
+  setTelemetryRefresh(REFRESH_PARTIAL);
+#endif
+  int PosX = (POS_IN_HUMIDITY % 2);
+  int PosY = static_cast<int>(POS_IN_HUMIDITY / 2);
+
   display.setPartialWindow(160 * PosX, 204 + (48 + 8) * PosY, 152, 48);
   display.firstPage();
   do
   {
-    // current weather data icons
-    display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY,
-                              house_humidity_48x48, 48, 48, GxEPD_BLACK);
+    drawCurrentInHumidity(inHumidity);
+  } while (displayNextPage());
+}
+#endif
+// end drawCurrentInHumidity
 
-    // current weather data labels
-    display.setFont(&FONT_7pt8b);
-    drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_INDOOR_HUMIDITY, LEFT);
+// drawCurrentInIaq
+#ifdef POS_IN_IAQ
+void drawCurrentInIaq(int inIaq)
+{
+  PROFILE_SCOPE(PROF_DRAW_INDOOR);
+  String dataStr;
+  int PosX = (POS_IN_IAQ % 2);
+  int PosY = static_cast<int>(POS_IN_IAQ / 2);
 
-    // indoor humidity
-    display.setFont(&FONT_12pt8b);
-    if (!std::isnan(inHumidity))
-    {
-      dataStr = String(static_cast<int>(std::round(inHumidity)));
-    }
-    else
-    {
-      dataStr = "--";
-    }
-    drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-    display.setFont(&FONT_8pt8b);
-    drawString(display.getCursorX(), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2,
-              "%", LEFT);
-  } while (display.nextPage());
+  // current weather data icons
+  display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY,
+                             house_48x48, 48, 48, GxEPD_BLACK);
+
+  // current weather data labels
+  display.setFont(&FONT_7pt8b);
+  drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY,
+             TXT_INDOOR_AIR_QUALITY, LEFT);
+
+  // indoor air quality index, 0 (clean) to 500
+  display.setFont(&FONT_12pt8b);
+  if (inIaq >= 0)
+  {
+    dataStr = String(inIaq);
+  }
+  else
+  {
+    dataStr = "--";
+  }
+  drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
+  display.setFont(&FONT_8pt8b);
+  drawString(display.getCursorX(), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2,
+             " IAQ", LEFT);
 }
+
+/* Updates the indoor air quality alone with a partial refresh.
+ */
+void refreshCurrentInIaq(int inIaq)
+{
+#if TELEMETRY
+  setTelemetryRefresh(REFRESH_PARTIAL);
 #endif
-// end drawCurrentInHumidity
+  int PosX = (POS_IN_IAQ % 2);
+  int PosY = static_cast<int>(POS_IN_IAQ / 2);
+
+  display.setPartialWindow(160 * PosX, 204 + (48 + 8) * PosY, 152, 48);
+  display.firstPage();
+  do
+  {
+    drawCurrentInIaq(inIaq);
+  } while (displayNextPage());
+}
+#endif
+// end drawCurrentInIaq
 
 // drawCurrentMoonrise
 #ifdef POS_MOONRISE
@@ -893,6 +1067,7 @@ void drawCurrentConditions(const owm_current_t &current,
                            const owm_daily_t &today,
                            const owm_resp_air_pollution_t &owm_air_pollution)
 {
+  PROFILE_SCOPE(PROF_DRAW_CURRENT);
   String dataStr, unitStr;
   // current weather icon
   display.drawInvertedBitmap(0, 0,
@@ -1006,10 +1181,11 @@ void drawCurrentConditions(const owm_current_t &current,
  */
 void drawForecast(const owm_daily_t *daily, tm timeInfo)
 {
+  PROFILE_SCOPE(PROF_DRAW_FORECAST);
   // 5 day, forecast
   String hiStr, loStr;
   String dataStr, unitStr;
-  for (int i = 0; i < 5; ++i)
+  for (int i = 0; i < NUM_FORECAST_DAYS; ++i)
   {
 #if EPD_PANEL != DISP_BW_V1
     int x = 398 + (i * 82);
@@ -1101,26 +1277,20 @@ void drawForecast(const owm_daily_t *daily, tm timeInfo)
   /* This function is responsible for drawing the current alerts if any.
    * Up to 2 alerts can be drawn.
    */
-  void drawAlerts(std::vector<owm_alerts_t> & alerts,
+  void drawAlerts(owm_resp_alerts_t & alerts,
                   const String &city, const String &date)
   {
+  PROFILE_SCOPE(PROF_DRAW_ALERTS);
 #if DEBUG_LEVEL >= 1
-  Serial.println("[debug] alerts.size()    : " + String(alerts.size()));
+  Serial.println("[debug] alerts.num       : " + String(alerts.num));
 #endif
-  if (alerts.size() == 0)
+  if (alerts.num == 0)
   { // no alerts to draw
     return;
   }
 
-  int *ignore_list = (int *)calloc(alerts.size(), sizeof(*ignore_list));
-  int *alert_indices = (int *)calloc(alerts.size(), sizeof(*alert_indices));
-  if (!ignore_list || !alert_indices)
-  {
-    Serial.println("Error: Failed to allocate memory while handling alerts.");
-    free(ignore_list);
-    free(alert_indices);
-    return;
-  }
+  uint32_t ignore_list = 0; // bit i set if alert i is not to be drawn
+  int alert_indices[OWM_NUM_ALERTS] = {};
 
   // Converts all event text and tags to lowercase, removes extra information,
   // and filters out redundant alerts of lesser urgency.
@@ -1139,12 +1309,13 @@ void drawForecast(const owm_daily_t *daily, tm timeInfo)
 #if DEBUG_LEVEL >= 1
   Serial.print("[debug] ignore_list      : [ ");
 #endif
-  for (int i = 0; i < alerts.size(); ++i)
+  for (int i = 0; i < alerts.num; ++i)
   {
+    bool ignored = ignore_list & (1UL << i);
 #if DEBUG_LEVEL >= 1
-    Serial.print(String(ignore_list[i]) + " ");
+    Serial.print(String(ignored) + " ");
 #endif
-    if (!ignore_list[i])
+    if (!ignored)
     {
       alert_indices[num_valid_alerts] = i;
       ++num_valid_alerts;
@@ -1159,28 +1330,29 @@ void drawForecast(const owm_daily_t *daily, tm timeInfo)
     // adjust max width to for 48x48 icons
     max_w -= 48;
 
-    owm_alerts_t &cur_alert = alerts[alert_indices[0]];
-    display.drawInvertedBitmap(196, 8, getAlertBitmap48(cur_alert), 48, 48,
-                               ACCENT_COLOR);
-    // must be called after getAlertBitmap
-    toTitleCase(cur_alert.event);
+    const owm_alerts_t &alert = alerts.list[alert_indices[0]];
+    char *event = &alerts.pool[alert.event.offset];
+    const uint8_t *bitmap =
+      getAlertBitmap48(static_cast<alert_category>(alert.category));
+    display.drawInvertedBitmap(196, 8, bitmap, 48, 48, ACCENT_COLOR);
+    toTitleCase(event);
 
     display.setFont(&FONT_14pt8b);
-    if (getStringWidth(cur_alert.event) <= max_w)
+    if (getStringWidth(event) <= max_w)
     { // Fits on a single line, draw along bottom
-      drawString(196 + 48 + 4, 24 + 8 - 12 + 20 + 1, cur_alert.event, LEFT);
+      drawString(196 + 48 + 4, 24 + 8 - 12 + 20 + 1, event, LEFT);
     }
     else
     { // use smaller font
       display.setFont(&FONT_12pt8b);
-      if (getStringWidth(cur_alert.event) <= max_w)
+      if (getStringWidth(event) <= max_w)
       { // Fits on a single line with smaller font, draw along bottom
-        drawString(196 + 48 + 4, 24 + 8 - 12 + 17 + 1, cur_alert.event, LEFT);
+        drawString(196 + 48 + 4, 24 + 8 - 12 + 17 + 1, event, LEFT);
       }
       else
       { // Does not fit on a single line, draw higher to allow room for 2nd line
         drawMultiLnString(196 + 48 + 4, 24 + 8 - 12 + 17 - 11,
-                          cur_alert.event, LEFT, max_w, 2, 23);
+                          event, LEFT, max_w, 2, 23);
       }
     }
   } // end 1 alert
@@ -1192,21 +1364,19 @@ void drawForecast(const owm_daily_t *daily, tm timeInfo)
     display.setFont(&FONT_12pt8b);
     for (int i = 0; i < 2; ++i)
     {
-      owm_alerts_t &cur_alert = alerts[alert_indices[i]];
+      const owm_alerts_t &alert = alerts.list[alert_indices[i]];
+      char *event = &alerts.pool[alert.event.offset];
 
-      display.drawInvertedBitmap(196, (i * 32), getAlertBitmap32(cur_alert),
-                                 32, 32, ACCENT_COLOR);
-      // must be called after getAlertBitmap
-      toTitleCase(cur_alert.event);
+      const uint8_t *bitmap =
+        getAlertBitmap32(static_cast<alert_category>(alert.category));
+      display.drawInvertedBitmap(196, (i * 32), bitmap, 32, 32, ACCENT_COLOR);
+      toTitleCase(event);
 
       drawMultiLnString(196 + 32 + 3, 5 + 17 + (i * 32),
-                        cur_alert.event, LEFT, max_w, 1, 0);
+                        event, LEFT, max_w, 1, 0);
     } // end for-loop
   } // end 2 alerts
 
-  free(ignore_list);
-  free(alert_indices);
-
   return;
 } // end drawAlerts
 
@@ -1215,6 +1385,7 @@ void drawForecast(const owm_daily_t *daily, tm timeInfo)
  */
 void drawLocationDate(const String &city, const String &date)
 {
+  PROFILE_SCOPE(PROF_DRAW_LOCATION);
   // location, date
   display.setFont(&FONT_16pt8b);
   drawString(DISP_WIDTH - 2, 23, city, RIGHT, ACCENT_COLOR);
@@ -1257,6 +1428,7 @@ int celsius_to_plot_y(float temp, int tempBoundMin, float yPxPerUnit,
 void drawOutlookGraph(const owm_hourly_t *hourly, const owm_daily_t *daily,
                       tm timeInfo)
 {
+  PROFILE_SCOPE(PROF_DRAW_OUTLOOK);
   const int xPos0 = 350;
   int xPos1 = DISP_WIDTH;
   const int yPos0 = 216;
@@ -1461,6 +1633,16 @@ void drawOutlookGraph(const owm_hourly_t *hourly, const owm_daily_t *daily,
 #if DISPLAY_HOURLY_ICONS
   int day_idx = 0;
 #endif
+
+  // x axis labels, the local time is converted once and then stepped forward
+  static strftime_prog_t hourFormat;
+  if (hourFormat.format != HOUR_FORMAT)
+  {
+    _strftime_compile(hourFormat, HOUR_FORMAT);
+  }
+  calendar_t labelTime;
+  calendarBegin(labelTime, hourly[0].dt);
+
   display.setFont(&FONT_8pt8b);
   for (int i = 0; i < HOURLY_GRAPH_MAX; ++i)
   {
@@ -1485,7 +1667,8 @@ void drawOutlookGraph(const owm_hourly_t *hourly, const owm_daily_t *daily,
       {
         ++day_idx;
       }
-      if ((i % hourInterval) == 0) // skip first and last tick
+      // skip first and last tick, and all of them when saving power
+      if ((i % hourInterval) == 0 && powerTier < POWER_TIER_2)
       {
         int y_b = INT_MAX;
         // find the highest (lowest in coordinate value) temperature point that
@@ -1552,9 +1735,8 @@ void drawOutlookGraph(const owm_hourly_t *hourly, const owm_daily_t *daily,
       display.drawLine(xTick + 1, yPos1 + 1, xTick + 1, yPos1 + 4, GxEPD_BLACK);
       // draw x axis labels
       char timeBuffer[12] = {}; // big enough to accommodate "hh:mm:ss am"
-      time_t ts = hourly[i].dt;
-      tm *timeInfo = localtime(&ts);
-      _strftime(timeBuffer, sizeof(timeBuffer), HOUR_FORMAT, timeInfo);
+      _strftime_hours(timeBuffer, sizeof(timeBuffer), hourFormat, labelTime,
+                      hourly[i].dt);
       drawString(xTick, yPos1 + 1 + 12 + 4 + 3, timeBuffer, CENTER);
     }
   }
@@ -1569,9 +1751,8 @@ void drawOutlookGraph(const owm_hourly_t *hourly, const owm_daily_t *daily,
     display.drawLine(xTick + 1, yPos1 + 1, xTick + 1, yPos1 + 4, GxEPD_BLACK);
     // draw x axis labels
     char timeBuffer[12] = {}; // big enough to accommodate "hh:mm:ss am"
-    time_t ts = hourly[HOURLY_GRAPH_MAX - 1].dt + 3600;
-    tm *timeInfo = localtime(&ts);
-    _strftime(timeBuffer, sizeof(timeBuffer), HOUR_FORMAT, timeInfo);
+    _strftime_hours(timeBuffer, sizeof(timeBuffer), hourFormat, labelTime,
+                    hourly[HOURLY_GRAPH_MAX - 1].dt + 3600);
     drawString(xTick, yPos1 + 1 + 12 + 4 + 3, timeBuffer, CENTER);
   }
 
@@ -1584,6 +1765,7 @@ void drawOutlookGraph(const owm_hourly_t *hourly, const owm_daily_t *daily,
 void drawStatusBar(const String &statusStr, const String &refreshTimeStr,
                    int rssi, uint32_t batVoltage)
 {
+  PROFILE_SCOPE(PROF_DRAW_STATUS);
   String dataStr;
   uint16_t dataColor = GxEPD_BLACK;
   display.setFont(&FONT_6pt8b);
@@ -1601,13 +1783,23 @@ void drawStatusBar(const String &statusStr, const String &refreshTimeStr,
     dataColor = ACCENT_COLOR;
   }
 #endif
-#if STATUS_BAR_EXTRAS_BAT_PERCENTAGE || STATUS_BAR_EXTRAS_BAT_VOLTAGE
+#if STATUS_BAR_EXTRAS_BAT_PERCENTAGE || STATUS_BAR_EXTRAS_BAT_VOLTAGE \
+    || (STATUS_BAR_EXTRAS_BAT_LIFE && ENERGY_ESTIMATION)
   dataStr = "";
 #if STATUS_BAR_EXTRAS_BAT_PERCENTAGE
   dataStr += String(batPercent) + "%";
 #endif
 #if STATUS_BAR_EXTRAS_BAT_VOLTAGE
   dataStr += " (" + String(std::round(batVoltage / 10.f) / 100.f, 2) + "v)";
+#endif
+#if STATUS_BAR_EXTRAS_BAT_LIFE && ENERGY_ESTIMATION
+  // estimated from previous wakes, this one has not finished yet
+  float batDays = estimateBatteryDays(batVoltage);
+  if (!std::isnan(batDays))
+  {
+    dataStr += " ~" + String(static_cast<int>(std::min(std::round(batDays),
+                                                       999.f))) + "d";
+  }
 #endif
   drawString(pos, DISP_HEIGHT - 1 - 2, dataStr, RIGHT, dataColor);
   pos -= getStringWidth(dataStr) + 1;
@@ -1616,6 +1808,14 @@ void drawStatusBar(const String &statusStr, const String &refreshTimeStr,
   display.drawInvertedBitmap(pos, DISP_HEIGHT - 1 - 17,
                              getBatBitmap24(batPercent), 24, 24, dataColor);
   pos -= sp + 9;
+#if POWER_TIERS
+  if (powerTier != POWER_TIER_NORMAL)
+  {
+    dataStr = String(TXT_POWER_SAVER) + " " + String(powerTier);
+    drawString(pos, DISP_HEIGHT - 1 - 2, dataStr, RIGHT, dataColor);
+    pos -= getStringWidth(dataStr) + sp + 9;
+  }
+#endif
 #endif
 
   // WiFi
@@ -1691,5 +1891,5 @@ void drawError(const uint8_t *bitmap_196x196,
     display.drawInvertedBitmap(DISP_WIDTH / 2 - 196 / 2,
                                DISP_HEIGHT / 2 - 196 / 2 - 21,
                                bitmap_196x196, 196, 196, ACCENT_COLOR);
-  } while (display.nextPage());
+  } while (displayNextPage());
 } // end drawError
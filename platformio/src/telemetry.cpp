@@ -0,0 +1,144 @@
+/* Telemetry for esp32-weather-epd.
+ * Copyright (C) 2026  Luke Marzen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "telemetry.h"
+
+#if TELEMETRY
+
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include <time.h>
+
+telemetry_record_t telemetry;
+
+// The last TELEMETRY_RECORDS wake cycles, record n is stored at
+// n % TELEMETRY_RECORDS. Survives deep sleep, but not a power loss or reset.
+RTC_DATA_ATTR static telemetry_record_t telemetryRing[TELEMETRY_RECORDS];
+RTC_DATA_ATTR static uint32_t telemetryRecords;
+RTC_DATA_ATTR static uint32_t telemetryUploadedSeq;
+
+/* Starts the record of this wake cycle. If PIN_TELEMETRY_DUMP is held low the
+ * stored records are printed first.
+ */
+void beginTelemetry()
+{
+  telemetry = {};
+  telemetry.wake_reason = esp_sleep_get_wakeup_cause();
+
+#if PIN_TELEMETRY_DUMP >= 0
+  pinMode(PIN_TELEMETRY_DUMP, INPUT_PULLUP);
+  delay(1); // let the pull-up settle
+  if (digitalRead(PIN_TELEMETRY_DUMP) == LOW)
+  {
+    printTelemetry(Serial, 0);
+  }
+  pinMode(PIN_TELEMETRY_DUMP, INPUT); // don't leak through the pull-up
+#endif
+  return;
+} // end beginTelemetry
+
+/* Ends the record of this wake cycle and stores it. cycle holds the phase
+ * times, or is NULL if the cycle was not profiled.
+ */
+void commitTelemetry(const profile_cycle_t *cycle)
+{
+  time_t now = time(nullptr);
+  telemetry.time = now < 1577836800 ? 0 : now; // not before 2020, never set
+  int64_t awake = esp_timer_get_time() / 1000;
+  telemetry.awake_ms = awake > UINT16_MAX ? UINT16_MAX : awake;
+  for (int p = 0; p < PROF_NUM_PHASES; ++p)
+  {
+    uint32_t ms = cycle ? (cycle->phase_us[p] + 500) / 1000 : 0;
+    telemetry.phase_ms[p] = ms > UINT16_MAX ? UINT16_MAX : ms;
+  }
+
+  telemetryRing[telemetryRecords % TELEMETRY_RECORDS] = telemetry;
+  ++telemetryRecords;
+  return;
+} // end commitTelemetry
+
+/* Records the most thorough display update of this cycle.
+ */
+void setTelemetryRefresh(telemetry_refresh_t refresh)
+{
+  if (refresh > telemetry.refresh)
+  {
+    telemetry.refresh = refresh;
+  }
+  return;
+} // end setTelemetryRefresh
+
+/* Prints the stored records numbered fromSeq and up as CSV, oldest first,
+ * preceded by a header line.
+ */
+void printTelemetry(Print &out, uint32_t fromSeq)
+{
+  out.print("seq,time,wake_reason,awake_ms,rssi,battery_mv,http_status,"
+            "rx_bytes,parse_error,refresh");
+  for (int p = 0; p < PROF_NUM_PHASES; ++p)
+  {
+    out.print(',');
+    out.print(profilePhaseName(static_cast<profile_phase_t>(p)));
+  }
+  out.println();
+
+  uint32_t seq = telemetryRecords > TELEMETRY_RECORDS
+                 ? telemetryRecords - TELEMETRY_RECORDS : 0;
+  if (seq < fromSeq)
+  {
+    seq = fromSeq;
+  }
+  for (; seq < telemetryRecords; ++seq)
+  {
+    const telemetry_record_t &r = telemetryRing[seq % TELEMETRY_RECORDS];
+    out.printf("%u,%u,%u,%u,%d,%u,%d,%u,%u,%u", (unsigned) seq,
+               (unsigned) r.time, r.wake_reason, r.awake_ms, r.rssi,
+               r.battery_mv, r.http_status, (unsigned) r.rx_bytes,
+               r.parse_error, r.refresh);
+    for (int p = 0; p < PROF_NUM_PHASES; ++p)
+    {
+      out.printf(",%u", r.phase_ms[p]);
+    }
+    out.println();
+  }
+  return;
+} // end printTelemetry
+
+/* Returns the number of records stored since power-on, the next record is
+ * numbered this.
+ */
+uint32_t telemetryCount()
+{
+  return telemetryRecords;
+} // end telemetryCount
+
+/* Returns the number of the first record that has not been uploaded.
+ */
+uint32_t telemetryUploaded()
+{
+  return telemetryUploadedSeq;
+} // end telemetryUploaded
+
+/* Marks the records before seq as uploaded, so they are not sent again.
+ */
+void setTelemetryUploaded(uint32_t seq)
+{
+  telemetryUploadedSeq = seq;
+  return;
+} // end setTelemetryUploaded
+
+#endif
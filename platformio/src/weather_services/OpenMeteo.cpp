@@ -2,7 +2,9 @@
 
 #include "weather_service.h"
 
+#include "astronomy.h"
 #include "config.h"
+#include "heap_tracker.h"
 
 #if HTTP_MODE == HTTPS_WITH_CERT_VERIF
 #include "cert.h"
@@ -35,31 +37,33 @@ String buildMainURL() {
 #endif
 
           "&hourly=temperature_2m" +
+#if FETCH_HOURLY_WEATHER
+          ",weather_code" +
+#endif
 #if DISPLAY_HOURLY_ICONS
-          ",weather_code,cloud_cover,wind_speed_10m,wind_gusts_10m,is_day" +
+          ",cloud_cover,wind_speed_10m,wind_gusts_10m,is_day" +
 #endif
-#if UNITS_HOURLY_PRECIP == POP
+#if FETCH_HOURLY_POP
           ",precipitation_probability" +
-#else
+#endif
+#if FETCH_HOURLY_PRECIP
           ",precipitation" +
 #endif
 
           "&daily=weather_code,cloud_cover_mean,wind_speed_10m_max,wind_gusts_10m_max,temperature_2m_max,temperature_2m_min" +
+#if DISPLAY_DAILY_PRECIP
 #if UNITS_DAILY_PRECIP == POP
           ",precipitation_probability_max" +
 #else
           ",precipitation_sum" +
 #endif
-#ifdef POS_SUNRISE
-          ",sunrise" +
-#endif
-#ifdef POS_SUNSET
-          ",sunset" +
 #endif
 #ifdef POS_UVI
           ",uv_index_max" +
 #endif
-          "&wind_speed_unit=ms&timezone=auto&timeformat=unixtime&forecast_days=5&forecast_hours=" + HOURLY_GRAPH_MAX;
+          "&wind_speed_unit=ms&timezone=auto&timeformat=unixtime" +
+          // only as many days and hours as drawForecast and the outlook graph show
+          "&forecast_days=" + NUM_FORECAST_DAYS + "&forecast_hours=" + HOURLY_GRAPH_MAX;
 }
 
 String buildPollutionURL(char* startStr, char* endStr) {
@@ -73,12 +77,32 @@ String getAPIKeyParam(String key) {
   return "";
 }
 
+/* Deserialization filters, the first element of an array filter applies to
+ * every element.
+ */
+static const char MAIN_FILTER[] =
+  "{\"current\":true,\"hourly\":true,\"daily\":true}";
+
+static const char AIR_POLLUTION_FILTER[] =
+  "{\"hourly\":{"
+    "\"time\":true,\"carbon_monoxide\":true,\"nitrogen_dioxide\":true,"
+    "\"ozone\":true,\"sulphur_dioxide\":true,\"pm2_5\":true,"
+    "\"pm10\":true,\"ammonia\":true"
+  "}}";
+
 DeserializationError deserializeMainCall(Stream &json,
                                               owm_resp_onecall_t &r)
 {
+  // the requested variables are already chosen by buildMainURL, this drops
+  // the *_units objects and location metadata that are never read
+  JsonDocument filter;
+  deserializeJson(filter, MAIN_FILTER);
+
   JsonDocument doc;
-  
-  DeserializationError error = deserializeJson(doc, json);
+
+  DeserializationError error = deserializeJson(doc, json,
+                                               DeserializationOption::Filter(filter));
+  HEAP_CHECKPOINT(HEAP_JSON_DOC);
 
 #if DEBUG_LEVEL >= 1
   Serial.println("[debug] doc.overflowed() : " + String(doc.overflowed()));
@@ -96,8 +120,6 @@ DeserializationError deserializeMainCall(Stream &json,
   JsonObject hourly = doc["hourly"];
 
   r.current.dt = current["time"].as<int64_t>();
-  r.current.sunrise = daily["sunrise"][0].as<int64_t>(); //
-  r.current.sunset = daily["sunset"][0].as<int64_t>();   //
   r.current.temp = current["temperature_2m"].as<float>();
   r.current.feels_like = current["apparent_temperature"].as<float>();
   r.current.pressure = current["surface_pressure"].as<int>(); //
@@ -135,10 +157,6 @@ DeserializationError deserializeMainCall(Stream &json,
   for (size_t i = 0; i < days; i++)
   {
     r.daily[i].dt = daily["time"][i].as<int64_t>();
-    // TODO: Open-Meteo does not provide lunar data. Calculate them or use another API.
-    // r.daily[i].moonrise   = daily["moonrise"]  .as<int64_t>();
-    // r.daily[i].moonset    = daily["moonset"]   .as<int64_t>();
-    // r.daily[i].moon_phase = daily["moon_phase"].as<float>();
     r.daily[i].temp.min = daily["temperature_2m_min"][i].as<float>();
     r.daily[i].temp.max = daily["temperature_2m_max"][i].as<float>();
     r.daily[i].clouds = daily["cloud_cover_mean"][i].as<int>();
@@ -154,22 +172,31 @@ DeserializationError deserializeMainCall(Stream &json,
     }
   }
 
+  // Open-Meteo does not provide lunar data, and the sun is computed locally to
+  // keep the request small. daily time is the start of each local day.
+  fillAstronomy(r, days);
+
   // TODO: Open-Meteo does not issue alerts, use another API.
   /*
 #if DISPLAY_ALERTS
-  i = 0;
+  r.alerts.num = 0;
+  r.alerts.pool_used = 0;
   for (JsonObject alerts : doc["alerts"].as<JsonArray>())
   {
-    owm_alerts_t new_alert = {};
-    new_alert.event = alerts["event"].as<const char *>();
-    new_alert.tags = alerts["tags"][0].as<const char *>();
-    r.alerts.push_back(new_alert);
+    owm_alerts_t &new_alert = r.alerts.list[r.alerts.num];
+    if (!storeAlertText(r.alerts, new_alert.event,
+                        alerts["event"].as<const char *>())
+     || !storeAlertText(r.alerts, new_alert.tags,
+                        alerts["tags"][0].as<const char *>()))
+    {
+      break; // out of pool space
+    }
+    ++r.alerts.num;
 
-    if (i == OWM_NUM_ALERTS - 1)
+    if (r.alerts.num == OWM_NUM_ALERTS)
     {
       break;
     }
-    ++i;
   }
 #endif
   */
@@ -180,9 +207,14 @@ DeserializationError deserializeMainCall(Stream &json,
 DeserializationError deserializeAirQuality(Stream &json,
                                            owm_resp_air_pollution_t &r)
 {
+  JsonDocument filter;
+  deserializeJson(filter, AIR_POLLUTION_FILTER);
+
   JsonDocument doc;
 
-  DeserializationError error = deserializeJson(doc, json);
+  DeserializationError error = deserializeJson(doc, json,
+                                               DeserializationOption::Filter(filter));
+  HEAP_CHECKPOINT(HEAP_JSON_DOC);
 #if DEBUG_LEVEL >= 1
   Serial.println("[debug] doc.overflowed() : " + String(doc.overflowed()));
   #endif
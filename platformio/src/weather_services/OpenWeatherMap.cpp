@@ -1,9 +1,12 @@
 #if WEATHER_API == OPEN_WEATHER_MAP
 
+#include <algorithm>
+
 #include "weather_service.h"
 
 #include "config.h"
 #include "_locale.h"
+#include "heap_tracker.h"
 
 #if HTTP_MODE == HTTPS_WITH_CERT_VERIF
 #include "cert.h"
@@ -18,7 +21,7 @@ const char* DOMAIN_POLLUTION = ENDPOINT_MAIN;
 
 String buildMainURL() {
   String url = "/data/" + OWM_ONECALL_VERSION + "/onecall?lat=" + LAT + "&lon=" + LON + "&lang=" + OWM_LANG + "&units=metric&exclude=minutely";
-#if !DISPLAY_ALERTS
+#if !FETCH_ALERTS
   // exclude alerts
   url += ",alerts";
 #endif
@@ -34,36 +37,127 @@ String getAPIKeyParam(String key) {
   return "&appid=" + key;
 }
 
+/* Deserialization filters, assembled by the preprocessor from the enabled
+ * widgets and features (see FETCH_* in config.h) so that the document only
+ * grows with the fields that are read.
+ * The first element of an array filter applies to every element.
+ */
+static const char MAIN_FILTER[] =
+  "{\"current\":{"
+    "\"dt\":true,\"temp\":true,\"feels_like\":true,\"clouds\":true,"
+    "\"wind_speed\":true,\"wind_gust\":true,"
+    "\"weather\":[{\"id\":true,\"icon\":true}]"
+#ifdef POS_SUNRISE
+    ",\"sunrise\":true"
+#endif
+#ifdef POS_SUNSET
+    ",\"sunset\":true"
+#endif
+#ifdef POS_WIND
+    ",\"wind_deg\":true"
+#endif
+#ifdef POS_HUMIDITY
+    ",\"humidity\":true"
+#endif
+#ifdef POS_PRESSURE
+    ",\"pressure\":true"
+#endif
+#ifdef POS_UVI
+    ",\"uvi\":true"
+#endif
+#ifdef POS_VISIBILITY
+    ",\"visibility\":true"
+#endif
+#ifdef POS_DEW_POINT
+    ",\"dew_point\":true"
+#endif
+  "},"
+  "\"hourly\":[{"
+    "\"dt\":true,\"temp\":true"
+#if FETCH_HOURLY_POP
+    ",\"pop\":true"
+#endif
+#if FETCH_HOURLY_PRECIP
+    ",\"rain\":{\"1h\":true},\"snow\":{\"1h\":true}"
+#endif
+#if DISPLAY_HOURLY_ICONS
+    ",\"clouds\":true,\"wind_speed\":true,\"wind_gust\":true"
+#endif
+#if FETCH_HOURLY_WEATHER
+    ",\"weather\":[{\"id\":true"
+#if DISPLAY_HOURLY_ICONS
+    ",\"icon\":true"
+#endif
+    "}]"
+#endif
+  "}],"
+  // moon data is needed by the current conditions and hourly icons too
+  "\"daily\":[{"
+    "\"dt\":true,\"moonrise\":true,\"moonset\":true,\"moon_phase\":true,"
+    "\"temp\":{\"min\":true,\"max\":true},\"clouds\":true,"
+    "\"wind_speed\":true,\"wind_gust\":true,\"weather\":[{\"id\":true}]"
+#if DISPLAY_DAILY_PRECIP
+#if UNITS_DAILY_PRECIP == POP
+    ",\"pop\":true"
+#else
+    ",\"rain\":true,\"snow\":true"
+#endif
+#endif
+  "}]"
+#if DISPLAY_ALERTS
+  // description can be very long so it is filtered out to save on memory
+  // along with sender_name
+  ",\"alerts\":[{\"event\":true,\"start\":true,\"end\":true,\"tags\":true}]"
+#elif FETCH_ALERTS
+  // only counted
+  ",\"alerts\":[{\"event\":false}]"
+#endif
+  "}";
+
+static const char AIR_POLLUTION_FILTER[] =
+  "{\"list\":[{\"components\":{"
+    "\"co\":true,\"no\":true,\"no2\":true,\"o3\":true,\"so2\":true,"
+    "\"pm2_5\":true,\"pm10\":true,\"nh3\":true"
+  "}}]}";
+
+#if DISPLAY_ALERTS
+/* Copies text into the alert pool and points span at it.
+ *
+ * Returns false if the pool does not have enough space left.
+ */
+static bool storeAlertText(owm_resp_alerts_t &alerts, owm_span_t &span,
+                           const char *text)
+{
+  if (text == nullptr)
+  {
+    text = "";
+  }
+  size_t len = strlen(text);
+  if (alerts.pool_used + len + 1 > OWM_ALERTS_POOL_SIZE)
+  {
+    return false;
+  }
+  span.offset = alerts.pool_used;
+  span.length = len;
+  memcpy(&alerts.pool[alerts.pool_used], text, len + 1);
+  alerts.pool_used += len + 1;
+  return true;
+} // end storeAlertText
+#endif
+
 DeserializationError deserializeMainCall(Stream &json,
                                         owm_resp_onecall_t &r)
 {
   int i;
 
   JsonDocument filter;
-  filter["current"] = true;
-  filter["minutely"] = false;
-  filter["hourly"] = true;
-  filter["daily"] = true;
-#if !DISPLAY_ALERTS
-  filter["alerts"] = false;
-#else
-  // description can be very long so they are filtered out to save on memory
-  // along with sender_name
-  for (int i = 0; i < OWM_NUM_ALERTS; ++i)
-  {
-    filter["alerts"][i]["sender_name"] = false;
-    filter["alerts"][i]["event"] = true;
-    filter["alerts"][i]["start"] = true;
-    filter["alerts"][i]["end"] = true;
-    filter["alerts"][i]["description"] = false;
-    filter["alerts"][i]["tags"] = true;
-  }
-#endif
+  deserializeJson(filter, MAIN_FILTER);
 
   JsonDocument doc;
 
   DeserializationError error = deserializeJson(doc, json,
                                                DeserializationOption::Filter(filter));
+  HEAP_CHECKPOINT(HEAP_JSON_DOC);
 #if DEBUG_LEVEL >= 1
   Serial.println("[debug] doc.overflowed() : " + String(doc.overflowed()));
 #endif
@@ -143,20 +237,27 @@ DeserializationError deserializeMainCall(Stream &json,
   }
 
 #if DISPLAY_ALERTS
-  i = 0;
+  r.alerts.num = 0;
+  r.alerts.pool_used = 0;
   for (JsonObject alerts : doc["alerts"].as<JsonArray>())
   {
-    owm_alerts_t new_alert = {};
-    new_alert.event = alerts["event"].as<const char *>();
-    new_alert.tags = alerts["tags"][0].as<const char *>();
-    r.alerts.push_back(new_alert);
+    owm_alerts_t &new_alert = r.alerts.list[r.alerts.num];
+    if (!storeAlertText(r.alerts, new_alert.event,
+                        alerts["event"].as<const char *>())
+     || !storeAlertText(r.alerts, new_alert.tags,
+                        alerts["tags"][0].as<const char *>()))
+    {
+      break; // out of pool space
+    }
+    ++r.alerts.num;
 
-    if (i == OWM_NUM_ALERTS - 1)
+    if (r.alerts.num == OWM_NUM_ALERTS)
     {
       break;
     }
-    ++i;
   }
+#elif FETCH_ALERTS
+  r.alerts.num = std::min<int>(doc["alerts"].size(), OWM_NUM_ALERTS);
 #endif
 
   return error;
@@ -167,9 +268,14 @@ DeserializationError deserializeAirQuality(Stream &json,
 {
   int i = 0;
 
+  JsonDocument filter;
+  deserializeJson(filter, AIR_POLLUTION_FILTER);
+
   JsonDocument doc;
 
-  DeserializationError error = deserializeJson(doc, json);
+  DeserializationError error = deserializeJson(doc, json,
+                                               DeserializationOption::Filter(filter));
+  HEAP_CHECKPOINT(HEAP_JSON_DOC);
 #if DEBUG_LEVEL >= 1
   Serial.println("[debug] doc.overflowed() : " + String(doc.overflowed()));
 #endif